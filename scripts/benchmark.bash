@@ -0,0 +1,25 @@
+#!/bin/bash
+
+cd ..
+
+mkdir bin &>/dev/null
+
+# Typed against untyped Array element access.
+gcc -O2 -o bin/benchmark_array \
+    -Isrc scripts/benchmark_array.c src/util/array.c src/util/arena.c \
+    -Wall -Werror -Wpedantic || exit $?
+
+bin/benchmark_array || exit $?
+
+# GJK against SAT narrow phase over 3 to 64 verticies.
+gcc -O2 -o bin/benchmark_gjk \
+    -Isrc scripts/benchmark_gjk.c \
+    src/model/gjk.c src/model/sat.c src/model/polygon.c \
+    src/model/broadphase.c src/util/array.c src/util/arena.c \
+    src/util/random.c \
+    $(sdl2-config --cflags --libs) -lm \
+    -Wall -Werror -Wpedantic || exit $?
+
+bin/benchmark_gjk || exit $?
+
+exit 0
@@ -0,0 +1,122 @@
+/**
+ * Benchmark of element access through the array_ functions of array.h
+ * against the typed functions defined by ARRAY_DEFINE() in typed_array.h.
+ * 
+ * Pushes BENCHMARK_ELEMENTS pairs onto an Array and reads every pair back
+ * BENCHMARK_PASSES times, once with array_push_back() and array_at_copy()
+ * and once with the typed push_back and at_copy, and prints the time per
+ * element of each. Built and run by benchmark.bash.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "util/array.h"
+#include "util/typed_array.h"
+
+// The number of elements pushed onto the array.
+#define BENCHMARK_ELEMENTS (1 << 20)
+
+// The number of times every element is read back.
+#define BENCHMARK_PASSES 20
+
+// The element type, the same size and layout as Pair.
+typedef struct {
+    int a;
+    int b;
+} BenchmarkPair;
+
+ARRAY_DEFINE(benchmark_pair_array, BenchmarkPair)
+
+/**
+ * Get the current time in nanoseconds from the monotonic clock.
+ */
+uint64_t benchmark_now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + time.tv_nsec;
+}
+
+/**
+ * Push and read back every element with the untyped functions.
+ * 
+ * @param sum Set to the sum of every element read, so the reads are not
+ * optimised away.
+ * @returns The nanoseconds taken.
+ */
+uint64_t benchmark_untyped(int64_t *sum)
+{
+    uint64_t start = benchmark_now();
+
+    Array *array = array_create(sizeof(BenchmarkPair));
+    for (int i = 0; i < BENCHMARK_ELEMENTS; i++) {
+        BenchmarkPair pair = {i, i + 1};
+        array_push_back(array, &pair);
+    }
+
+    for (int pass = 0; pass < BENCHMARK_PASSES; pass++) {
+        for (int i = 0; i < BENCHMARK_ELEMENTS; i++) {
+            BenchmarkPair pair = {0, 0};
+            array_at_copy(array, i, &pair);
+            *sum += pair.a + pair.b;
+        }
+    }
+
+    array_destroy(array);
+    return benchmark_now() - start;
+}
+
+/**
+ * Push and read back every element with the typed functions.
+ * 
+ * @param sum Set to the sum of every element read, so the reads are not
+ * optimised away.
+ * @returns The nanoseconds taken.
+ */
+uint64_t benchmark_typed(int64_t *sum)
+{
+    uint64_t start = benchmark_now();
+
+    Array *array = benchmark_pair_array_create();
+    for (int i = 0; i < BENCHMARK_ELEMENTS; i++)
+        benchmark_pair_array_push_back(array, (BenchmarkPair){i, i + 1});
+
+    for (int pass = 0; pass < BENCHMARK_PASSES; pass++) {
+        for (int i = 0; i < BENCHMARK_ELEMENTS; i++) {
+            BenchmarkPair pair = {0, 0};
+            benchmark_pair_array_at_copy(array, i, &pair);
+            *sum += pair.a + pair.b;
+        }
+    }
+
+    benchmark_pair_array_destroy(array);
+    return benchmark_now() - start;
+}
+
+int main(int argc, char *argv[])
+{
+    int64_t untyped_sum = 0;
+    int64_t typed_sum = 0;
+    uint64_t untyped = benchmark_untyped(&untyped_sum);
+    uint64_t typed = benchmark_typed(&typed_sum);
+
+    // Every element is pushed once and read once per pass.
+    double elements = (double)BENCHMARK_ELEMENTS * (BENCHMARK_PASSES + 1);
+
+    printf(
+        "array_push_back + array_at_copy: %.2f ns per element.\n",
+        untyped / elements
+    );
+    printf(
+        "typed push_back + at_copy:       %.2f ns per element.\n",
+        typed / elements
+    );
+    printf("Speedup: %.1fx.\n", (double)untyped / typed);
+
+    // Both loops must read the same elements.
+    return untyped_sum == typed_sum ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/**
+ * Benchmark of the GJK narrow phase in gjk.h against the batched seperating
+ * axis test in sat.h, across regular polygons of 3 to 64 verticies.
+ * 
+ * For each vertex count, BENCHMARK_PAIRS pairs of polygons are placed at
+ * random, about half of them overlapping, and turned slightly before each of
+ * BENCHMARK_PASSES passes. Every pass tests every pair with SAT, with GJK
+ * from an empty simplex, and with GJK from each pair's simplex of the last
+ * pass as the model does. Prints the time per pair of each, and the number of
+ * pairs on which GJK and SAT disagree. Built and run by benchmark.bash.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "util/array.h"
+#include "util/vector.h"
+#include "model/polygon.h"
+#include "model/sat.h"
+#include "model/gjk.h"
+
+// The number of pairs of polygons tested per vertex count.
+#define BENCHMARK_PAIRS 1024
+
+// The number of times every pair is tested.
+#define BENCHMARK_PASSES 50
+
+// The most verticies of a benchmarked polygon.
+#define BENCHMARK_VERTICIES 64
+
+// The angle each polygon turns by between passes, in radians.
+#define BENCHMARK_TURN 0.01
+
+/**
+ * The polygons of every pair, placed in world space.
+ */
+typedef struct {
+    // The local verticies and seperating axes of the polygon shape.
+    Vector *local_verticies;
+    Vector *local_axes;
+    int n;
+    int m;
+    // The position and angle of each polygon.
+    Vector *position;
+    double *angle;
+    // The world verticies and axes of each polygon, BENCHMARK_VERTICIES each.
+    Vector *verticies;
+    Vector *axes;
+    // The hull of each polygon, and the pairs of hulls to test.
+    Hull *hulls;
+    Pair *pairs;
+} Benchmark;
+
+/**
+ * Get the current time in nanoseconds from the monotonic clock.
+ */
+uint64_t benchmark_now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + time.tv_nsec;
+}
+
+/**
+ * Get a random double between min and max.
+ */
+double benchmark_random(double min, double max)
+{
+    return min + (max - min) * rand() / RAND_MAX;
+}
+
+/**
+ * Transform every polygon's local verticies and axes into world space.
+ */
+void benchmark_place(Benchmark *benchmark)
+{
+    for (int i = 0; i < 2 * BENCHMARK_PAIRS; i++) {
+        double c = cos(benchmark->angle[i]);
+        double s = sin(benchmark->angle[i]);
+
+        Vector *verticies = benchmark->verticies + i * BENCHMARK_VERTICIES;
+        for (int j = 0; j < benchmark->n; j++) {
+            Vector local = benchmark->local_verticies[j];
+            verticies[j] = vector_add(
+                vector_rot_cs(local, c, s),
+                benchmark->position[i]
+            );
+        }
+
+        Vector *axes = benchmark->axes + i * BENCHMARK_VERTICIES;
+        for (int j = 0; j < benchmark->m; j++)
+            axes[j] = vector_rot_cs(benchmark->local_axes[j], c, s);
+
+        benchmark->hulls[i] = (Hull){
+            verticies, benchmark->n, axes, benchmark->m
+        };
+    }
+}
+
+/**
+ * Benchmark one vertex count and print its row of results.
+ */
+void benchmark_run(int n)
+{
+    Array *polygon = polygon_create_regular(n, 1.0);
+    Array *axes = polygon_axes(polygon);
+
+    Benchmark benchmark = {
+        array_data(polygon),
+        array_data(axes),
+        n,
+        array_length(axes),
+        malloc(2 * BENCHMARK_PAIRS * sizeof(Vector)),
+        malloc(2 * BENCHMARK_PAIRS * sizeof(double)),
+        malloc(2 * BENCHMARK_PAIRS * BENCHMARK_VERTICIES * sizeof(Vector)),
+        malloc(2 * BENCHMARK_PAIRS * BENCHMARK_VERTICIES * sizeof(Vector)),
+        malloc(2 * BENCHMARK_PAIRS * sizeof(Hull)),
+        malloc(BENCHMARK_PAIRS * sizeof(Pair))
+    };
+
+    Collision *sat = malloc(BENCHMARK_PAIRS * sizeof(Collision));
+    Collision *gjk = malloc(BENCHMARK_PAIRS * sizeof(Collision));
+    Simplex *simplices = calloc(BENCHMARK_PAIRS, sizeof(Simplex));
+
+    // Place the second polygon of each pair within about two radii of the
+    // first, so that about half of the pairs overlap.
+    for (int i = 0; i < BENCHMARK_PAIRS; i++) {
+        Vector a = {benchmark_random(-10, 10), benchmark_random(-10, 10)};
+        double theta = benchmark_random(0, 2 * M_PI);
+        double distance = benchmark_random(0, 2.5);
+
+        benchmark.position[2 * i] = a;
+        benchmark.position[2 * i + 1] = vector_add(
+            a,
+            (Vector){distance * cos(theta), distance * sin(theta)}
+        );
+        benchmark.angle[2 * i] = benchmark_random(0, 2 * M_PI);
+        benchmark.angle[2 * i + 1] = benchmark_random(0, 2 * M_PI);
+        benchmark.pairs[i] = pair_create(2 * i, 2 * i + 1);
+    }
+
+    uint64_t sat_time = 0;
+    uint64_t cold_time = 0;
+    uint64_t warm_time = 0;
+    int fallbacks = 0;
+    int disagreements = 0;
+
+    for (int pass = 0; pass < BENCHMARK_PASSES; pass++) {
+
+        for (int i = 0; i < 2 * BENCHMARK_PAIRS; i++)
+            benchmark.angle[i] += BENCHMARK_TURN;
+        benchmark_place(&benchmark);
+
+        uint64_t start = benchmark_now();
+        sat_colliding_batch(
+            benchmark.hulls,
+            benchmark.pairs,
+            BENCHMARK_PAIRS,
+            NULL,
+            sat
+        );
+        sat_time += benchmark_now() - start;
+
+        start = benchmark_now();
+        for (int i = 0; i < BENCHMARK_PAIRS; i++) {
+            Simplex cold = {0};
+            Hull *A = benchmark.hulls + 2 * i;
+            gjk_colliding(A, A + 1, &cold, gjk + i);
+        }
+        cold_time += benchmark_now() - start;
+
+        start = benchmark_now();
+        for (int i = 0; i < BENCHMARK_PAIRS; i++) {
+            Hull *A = benchmark.hulls + 2 * i;
+            if (gjk_colliding(A, A + 1, simplices + i, gjk + i))
+                continue;
+
+            // Fall back to SAT as the model does.
+            simplices[i] = (Simplex){0};
+            sat_colliding_batch(
+                benchmark.hulls,
+                benchmark.pairs + i,
+                1,
+                NULL,
+                gjk + i
+            );
+            fallbacks++;
+        }
+        warm_time += benchmark_now() - start;
+
+        for (int i = 0; i < BENCHMARK_PAIRS; i++)
+            disagreements += sat[i].colliding != gjk[i].colliding;
+    }
+
+    double tests = (double)BENCHMARK_PAIRS * BENCHMARK_PASSES;
+    printf(
+        "%9i %12.1f %12.1f %12.1f %10i %10i\n",
+        n,
+        sat_time / tests,
+        cold_time / tests,
+        warm_time / tests,
+        fallbacks,
+        disagreements
+    );
+
+    free(benchmark.position);
+    free(benchmark.angle);
+    free(benchmark.verticies);
+    free(benchmark.axes);
+    free(benchmark.hulls);
+    free(benchmark.pairs);
+    free(sat);
+    free(gjk);
+    free(simplices);
+    array_destroy(polygon);
+    array_destroy(axes);
+}
+
+int main(int argc, char *argv[])
+{
+    srand(1);
+
+    printf(
+        "%9s %12s %12s %12s %10s %10s\n",
+        "verticies",
+        "SAT ns",
+        "GJK cold ns",
+        "GJK warm ns",
+        "fallbacks",
+        "disagree"
+    );
+
+    int counts[] = {3, 4, 5, 6, 8, 12, 16, 24, 32, 48, 64};
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++)
+        benchmark_run(counts[i]);
+
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include "SDL2/SDL.h"
 #include "view/view.h"
 #include "model/model.h"
+#include "util/time.h"
 #include "util/vector.h"
 
 /**
@@ -109,6 +110,30 @@ void controller_thread(Controller *controller)
     }
 }
 
+void controller_send(Controller *controller, Command command, bool model)
+{
+    // Drop the command rather than wait for the model or view to catch up.
+    // Dropped commands are counted by the model and view.
+    if (model)
+        model_command(controller->model, command);
+    else
+        view_command(controller->view, command);
+}
+
+void controller_move(Controller *controller, Direction direction, bool state)
+{
+    Command command = {COMMAND_VIEW_MOVE, time_global()};
+    command.move.direction = direction;
+    command.move.state = state;
+    controller_send(controller, command, false);
+}
+
+void controller_pause_toggle(Controller *controller)
+{
+    Command command = {COMMAND_MODEL_PAUSE_TOGGLE, time_global()};
+    controller_send(controller, command, true);
+}
+
 void controller_handle_event(Controller *controller, SDL_Event *event)
 {
     // Jump to the function that handles the specific type of event.
@@ -141,12 +166,12 @@ void controller_handle_key_up(Controller *controller, SDL_Event *event)
 
     switch (event->key.keysym.sym)
     {
-        case SDLK_UP:    view_move(controller->view, DIRECTION_NORTH, false); break;
-        case SDLK_RIGHT: view_move(controller->view, DIRECTION_EAST,  false); break;
-        case SDLK_DOWN:  view_move(controller->view, DIRECTION_SOUTH, false); break;
-        case SDLK_LEFT:  view_move(controller->view, DIRECTION_WEST,  false); break;
-        case SDLK_e:     view_move(controller->view, DIRECTION_IN,    false); break;
-        case SDLK_q:     view_move(controller->view, DIRECTION_OUT,   false); break;
+        case SDLK_UP:    controller_move(controller, DIRECTION_NORTH, false); break;
+        case SDLK_RIGHT: controller_move(controller, DIRECTION_EAST,  false); break;
+        case SDLK_DOWN:  controller_move(controller, DIRECTION_SOUTH, false); break;
+        case SDLK_LEFT:  controller_move(controller, DIRECTION_WEST,  false); break;
+        case SDLK_e:     controller_move(controller, DIRECTION_IN,    false); break;
+        case SDLK_q:     controller_move(controller, DIRECTION_OUT,   false); break;
         default: break;
     }
 }
@@ -161,13 +186,13 @@ void controller_handle_key_down(Controller *controller, SDL_Event *event)
 
     switch (event->key.keysym.sym)
     {
-        case SDLK_UP:    view_move(controller->view, DIRECTION_NORTH, true); break;
-        case SDLK_RIGHT: view_move(controller->view, DIRECTION_EAST,  true); break;
-        case SDLK_DOWN:  view_move(controller->view, DIRECTION_SOUTH, true); break;
-        case SDLK_LEFT:  view_move(controller->view, DIRECTION_WEST,  true); break;
-        case SDLK_e:     view_move(controller->view, DIRECTION_IN,    true); break;
-        case SDLK_q:     view_move(controller->view, DIRECTION_OUT,   true); break;
-        case SDLK_SPACE: model_pause_toggle(controller->model); break;
+        case SDLK_UP:    controller_move(controller, DIRECTION_NORTH, true); break;
+        case SDLK_RIGHT: controller_move(controller, DIRECTION_EAST,  true); break;
+        case SDLK_DOWN:  controller_move(controller, DIRECTION_SOUTH, true); break;
+        case SDLK_LEFT:  controller_move(controller, DIRECTION_WEST,  true); break;
+        case SDLK_e:     controller_move(controller, DIRECTION_IN,    true); break;
+        case SDLK_q:     controller_move(controller, DIRECTION_OUT,   true); break;
+        case SDLK_SPACE: controller_pause_toggle(controller); break;
         case SDLK_ESCAPE: controller->done = true;
         default: break;
     }
@@ -191,11 +216,10 @@ void controller_handle_resize(Controller *controller, SDL_Event *event)
     {
         case SDL_WINDOWEVENT_SIZE_CHANGED:
         case SDL_WINDOWEVENT_RESIZED: {
-            view_resize_window(
-                controller->view,
-                event->window.data1,
-                event->window.data2
-            );
+            Command command = {COMMAND_VIEW_RESIZE, time_global()};
+            command.resize.x = event->window.data1;
+            command.resize.y = event->window.data2;
+            controller_send(controller, command, false);
             break;
         }
         default: break;
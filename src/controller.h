@@ -3,6 +3,8 @@
 
 #include "SDL2/SDL.h"
 
+#include "util/definitions.h"
+
 typedef struct Controller Controller;
 
 #define WINDOW_WIDTH 1200
@@ -32,6 +34,32 @@ Controller *controller_create();
  */
 void controller_thread(Controller *controller);
 
+/**
+ * Queue a command for the model or view, without waiting for either. If the
+ * queue is full the command is dropped, and counted by the model or view.
+ * 
+ * @param controller Pointer to the main Controller instance.
+ * @param command The command to send.
+ * @param model True to send the command to the model, false to the view.
+ */
+void controller_send(Controller *controller, Command command, bool model);
+
+/**
+ * Instruct the view to start or stop moving in a direction.
+ * 
+ * @param controller Pointer to the main Controller instance.
+ * @param direction The direction to move the view.
+ * @param state Whether to start or stop moving in the direction.
+ */
+void controller_move(Controller *controller, Direction direction, bool state);
+
+/**
+ * Instruct the model to pause or resume.
+ * 
+ * @param controller Pointer to the main Controller instance.
+ */
+void controller_pause_toggle(Controller *controller);
+
 /**
  * Handle a user event from a controller.
  * 
@@ -0,0 +1,153 @@
+#include "headless.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "model/model.h"
+#include "util/array.h"
+#include "util/time.h"
+
+int headless_time_compare(const void *a, const void *b)
+{
+    Time x = *(const Time*)a;
+    Time y = *(const Time*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Get a percentile of sorted tick times, in microseconds.
+ */
+double headless_percentile(Time *times, int n, double percentile)
+{
+    int index = (int)(percentile / 100.0 * (n - 1) + 0.5);
+    return (double)times[index] / 1000.0;
+}
+
+/**
+ * Print the statistics of the time each tick took and of the model.
+ */
+void headless_report(
+    Array *durations,
+    Time elapsed,
+    ModelStatistics *statistics
+) {
+    int n = array_length(durations);
+    if (n == 0) {
+        printf("Headless: no ticks run.\n");
+        return;
+    }
+
+    Time *times = array_data(durations);
+    qsort(times, n, sizeof(Time), headless_time_compare);
+
+    Time total = 0;
+    for (int i = 0; i < n; i++)
+        total += times[i];
+
+    printf(
+        "Headless: %i ticks in %.3f s, %.1f ticks per second.\n",
+        n,
+        time_to_seconds(elapsed),
+        n / time_to_seconds(elapsed)
+    );
+
+    printf(
+        "Tick time (us): min %.1f, mean %.1f, p50 %.1f, p90 %.1f, "
+        "p99 %.1f, max %.1f.\n",
+        (double)times[0] / 1000.0,
+        (double)total / n / 1000.0,
+        headless_percentile(times, n, 50),
+        headless_percentile(times, n, 90),
+        headless_percentile(times, n, 99),
+        (double)times[n - 1] / 1000.0
+    );
+
+    printf(
+        "Collisions: %llu candidates, %llu circle rejects, %llu axis hits, "
+        "%llu axis misses, %llu swept, %llu swept hits.\n",
+        (unsigned long long)statistics->candidates,
+        (unsigned long long)statistics->circle_rejects,
+        (unsigned long long)statistics->axis_hits,
+        (unsigned long long)statistics->axis_misses,
+        (unsigned long long)statistics->ccd_tests,
+        (unsigned long long)statistics->ccd_hits
+    );
+
+    printf(
+        "Asteroids: %i live, %i at most, capacity for %i, %llu spawned, "
+        "%llu despawned.\n",
+        statistics->asteroids,
+        statistics->asteroid_high_water,
+        statistics->asteroid_capacity,
+        (unsigned long long)statistics->spawns,
+        (unsigned long long)statistics->despawns
+    );
+
+    printf(
+        "Memory: %zu of %zu scratch bytes at most.\n",
+        statistics->scratch_high_water,
+        statistics->scratch_capacity
+    );
+}
+
+int headless_run(int ticks, double seconds, int respawns)
+{
+    Model *model = model_create_headless();
+    if (!model) {
+        printf("Failed to create model. Exiting.");
+        return 1;
+    }
+
+    if (ticks == 0 && seconds <= 0.0)
+        ticks = HEADLESS_TICKS;
+
+    // Reserve the tick times up front when the number of ticks is known, so
+    // recording them does not touch the heap between ticks.
+    Array *durations = array_create(sizeof(Time));
+    if (!durations || (ticks > 0 && !array_reserve(durations, ticks))) {
+        printf("Failed to allocate tick times. Exiting.");
+        array_destroy(durations);
+        model_destroy(model);
+        return 1;
+    }
+
+    double step = 1.0 / MODEL_TICK_RATE;
+    Time duration = (Time)(seconds * TIME_SECOND);
+    Time start = time_global();
+    Time now = start;
+
+    int tick = 0;
+    while (ticks > 0 ? tick < ticks : now - start < duration) {
+
+        // Grow the tick times before timing the tick when running for a
+        // number of seconds, so that growing is not counted in any tick. Stop
+        // if no more ticks can be recorded.
+        if (durations->length == durations->capacity) {
+            int capacity = durations->capacity;
+            if (capacity > INT_MAX - HEADLESS_CHUNK)
+                break;
+            if (!array_reserve(durations, capacity + HEADLESS_CHUNK))
+                break;
+        }
+
+        Time before = time_global();
+        for (int i = 0; i < respawns; i++)
+            model_respawn(model);
+        model_step(model, step);
+        now = time_global();
+
+        Time elapsed = now - before;
+        if (!array_push_back(durations, &elapsed))
+            break;
+
+        tick++;
+    }
+
+    ModelStatistics statistics = model_statistics(model);
+    headless_report(durations, now - start, &statistics);
+
+    array_destroy(durations);
+    model_destroy(model);
+    return 0;
+}
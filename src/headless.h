@@ -0,0 +1,35 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+// The number of ticks run in headless mode when neither a number of ticks or
+// seconds is given.
+#define HEADLESS_TICKS 600
+
+// The number of tick times the buffer of tick times grows by when running for
+// a number of seconds.
+#define HEADLESS_CHUNK 4096
+
+/**
+ * Run the model without a window, renderer or view, for profiling the model
+ * in isolation or running it on machines without a display.
+ * 
+ * Creates only the model, and steps it at its fixed tick rate as fast as
+ * possible rather than in real time, for either a number of ticks or a number
+ * of seconds. Each tick may despawn and respawn asteroids before stepping, to
+ * exercise spawning. On exit, prints statistics of the time each tick took and
+ * of the model's collision detection and memory.
+ * 
+ * The time interface must be initialised.
+ * 
+ * @param ticks The number of ticks to run, or 0 to run for a number of
+ * seconds.
+ * @param seconds The number of seconds to run for if ticks is 0.
+ * @param respawns The number of asteroids despawned at random and spawned
+ * again at the start of each tick, which is counted in the tick's time.
+ * 
+ * @returns 0 on success, or 1 if the model or the buffer of tick times could
+ * not be created.
+ */
+int headless_run(int ticks, double seconds, int respawns);
+
+#endif // HEADLESS_H
@@ -1,13 +1,139 @@
 #include "SDL2/SDL.h"
 
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "controller.h"
+#include "headless.h"
 #include "util/time.h"
 #include "util/random.h"
 
+/**
+ * Parse a count, such as a number of ticks, from a command line argument.
+ * 
+ * @param text The argument.
+ * @param count Set to the count.
+ * 
+ * @returns True if the argument is a whole number from 1 to INT_MAX, otherwise
+ * false.
+ */
+bool main_parse_count(const char *text, int *count)
+{
+    // strtoull() accepts and negates a leading minus sign, so reject it.
+    while (isspace((unsigned char)*text))
+        text++;
+    if (*text == '-')
+        return false;
+
+    char *end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+
+    if (errno != 0 || end == text || *end != '\0')
+        return false;
+    if (value < 1 || value > INT_MAX)
+        return false;
+
+    *count = (int)value;
+    return true;
+}
+
+/**
+ * Parse a number of seconds from a command line argument.
+ * 
+ * @param text The argument.
+ * @param seconds Set to the number of seconds.
+ * 
+ * @returns True if the argument is a finite positive number, otherwise false.
+ */
+bool main_parse_seconds(const char *text, double *seconds)
+{
+    char *end = NULL;
+    errno = 0;
+    double value = strtod(text, &end);
+
+    if (errno != 0 || end == text || *end != '\0')
+        return false;
+    if (!isfinite(value) || value <= 0.0)
+        return false;
+
+    *seconds = value;
+    return true;
+}
+
+/**
+ * Run the model without a window, as in
+ * 
+ *     Asteroids --headless [--ticks N | --seconds N] [--respawns N]
+ * 
+ * @returns The exit status.
+ */
+int main_headless(int argc, char* argv[])
+{
+    int ticks = 0;
+    double seconds = 0.0;
+    int respawns = 0;
+
+    for (int i = 1; i < argc; i++) {
+
+        bool valid = true;
+        if (strcmp(argv[i], "--headless") == 0)
+            continue;
+        else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+            valid = main_parse_count(argv[++i], &ticks);
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            valid = main_parse_seconds(argv[++i], &seconds);
+        else if (strcmp(argv[i], "--respawns") == 0 && i + 1 < argc)
+            valid = main_parse_count(argv[++i], &respawns);
+        else
+            valid = false;
+
+        if (!valid) {
+            printf(
+                "Invalid argument %s. Usage: "
+                "Asteroids --headless [--ticks N | --seconds N] "
+                "[--respawns N], where N is a positive number, and ticks and "
+                "respawns at most %i.\n",
+                argv[i],
+                INT_MAX
+            );
+            return 1;
+        }
+    }
+
+    // Only the timer subsystem is needed without a window.
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        printf("Failed to initialise SDL: %s. Exiting.", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    time_initialise();
+    random_initialise();
+
+    int status = headless_run(ticks, seconds, respawns);
+
+    time_deinitialise();
+    random_deinitialise();
+
+    SDL_Quit();
+    return status;
+}
+
 int main(int argc, char* argv[])
 {
+    // Run without a window or renderer if requested.
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0)
+            return main_headless(argc, argv);
+    }
+
     // Initialise SDL.
     if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
         printf("Failed to initialise SDL: %s. Exiting.", SDL_GetError());
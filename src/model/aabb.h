@@ -0,0 +1,117 @@
+#ifndef AABB_H
+#define AABB_H
+
+#include <stdbool.h>
+
+#include "util/vector.h"
+
+/**
+ * An axis aligned bounding box, described by its minimum (bottom left) and
+ * maximum (top right) corners in world space.
+ */
+typedef struct {
+    Vector min; // Bottom left corner.
+    Vector max; // Top right corner.
+} AABB;
+
+/**
+ * Check if two axis aligned bounding boxes overlap. Touching boxes are
+ * considered overlapping.
+ * 
+ * @param a The first box.
+ * @param b The second box.
+ * 
+ * @return True if the boxes overlap, otherwise false.
+ */
+static inline bool aabb_overlap(AABB a, AABB b)
+{
+    return (
+        a.min.x <= b.max.x && b.min.x <= a.max.x &&
+        a.min.y <= b.max.y && b.min.y <= a.max.y
+    );
+}
+
+/**
+ * Calculate the centre of an axis aligned bounding box.
+ * 
+ * @param a The box.
+ * 
+ * @return The centre of the box.
+ */
+static inline Vector aabb_centre(AABB a)
+{
+    Vector centre = {(a.min.x + a.max.x) * 0.5, (a.min.y + a.max.y) * 0.5};
+    return centre;
+}
+
+/**
+ * Calculate the smallest box containing two boxes.
+ * 
+ * @param a The first box.
+ * @param b The second box.
+ * 
+ * @return The union of both boxes.
+ */
+static inline AABB aabb_union(AABB a, AABB b)
+{
+    AABB c = {
+        {
+            a.min.x < b.min.x ? a.min.x : b.min.x,
+            a.min.y < b.min.y ? a.min.y : b.min.y
+        },
+        {
+            a.max.x > b.max.x ? a.max.x : b.max.x,
+            a.max.y > b.max.y ? a.max.y : b.max.y
+        }
+    };
+    return c;
+}
+
+/**
+ * Check if a box entirely contains another box.
+ * 
+ * @param a The containing box.
+ * @param b The contained box.
+ * 
+ * @return True if b is inside a, otherwise false.
+ */
+static inline bool aabb_contains(AABB a, AABB b)
+{
+    return (
+        a.min.x <= b.min.x && a.min.y <= b.min.y &&
+        b.max.x <= a.max.x && b.max.y <= a.max.y
+    );
+}
+
+/**
+ * Calculate the perimeter of a box. Used as the cost of a box in bounding
+ * volume hierarchies, as it is proportional to the chance of a random line
+ * hitting it.
+ * 
+ * @param a The box.
+ * 
+ * @return The perimeter of the box.
+ */
+static inline double aabb_perimeter(AABB a)
+{
+    return 2.0 * ((a.max.x - a.min.x) + (a.max.y - a.min.y));
+}
+
+/**
+ * Grow a box by a margin in every direction.
+ * 
+ * @param a The box.
+ * @param margin The distance to extend each side by.
+ * 
+ * @return The grown box.
+ */
+static inline AABB aabb_fatten(AABB a, double margin)
+{
+    AABB c = {
+        {a.min.x - margin, a.min.y - margin},
+        {a.max.x + margin, a.max.y + margin}
+    };
+    return c;
+}
+
+#endif // AABB_H
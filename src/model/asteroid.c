@@ -1,44 +1,36 @@
 #include "model/asteroid.h"
 
-Asteroid *asteroid_create()
+#include "util/random.h"
+
+Asteroid *asteroid_create(ShapeLibrary *shapes, Pool *asteroids, Pool *objects)
 {
-    Asteroid *asteroid = malloc(sizeof(Asteroid));
+    Asteroid *asteroid = asteroids
+        ? pool_allocate(asteroids)
+        : malloc(sizeof(Asteroid));
     if (!asteroid)
         return NULL;
 
-    asteroid->object = object_create();
-    asteroid->polygon = polygon_create_random_regular(1);
-    asteroid->verticies = array_create_from_array(asteroid->polygon);
+    asteroid->object = object_create(objects);
+    if (!asteroid->object) {
+        asteroid_destroy(asteroid, asteroids, objects);
+        return NULL;
+    }
 
-    return asteroid;
-}
+    asteroid->shape = random_int(0, shape_library_length(shapes) - 1);
+    asteroid->scale = 1.0;
 
-void asteroid_advance(Asteroid *asteroid, double seconds)
-{
-    object_advance(asteroid->object, seconds);
-
-    Vector *verticies = array_data(asteroid->polygon);
-    Vector *coordinates = array_data(asteroid->verticies);
-    int n = array_length(asteroid->verticies);
-
-    // Calculate the new verticies. Rotate by the current angle and add the
-    // position offset.
-    for (int i = 0; i < n; i++) {
-        *(coordinates + i) = vector_add(
-            vector_rot(*(verticies + i), asteroid->object->angle),
-            asteroid->object->position
-        );
-    }
+    return asteroid;
 }
 
-void asteroid_destroy(Asteroid *asteroid)
+void asteroid_destroy(Asteroid *asteroid, Pool *asteroids, Pool *objects)
 {
     if (!asteroid)
         return;
 
-    object_destroy(asteroid->object);
-    array_destroy(asteroid->polygon);
-    array_destroy(asteroid->verticies);
+    object_destroy(asteroid->object, objects);
 
-    free(asteroid);
+    if (asteroids)
+        pool_free(asteroids, asteroid);
+    else
+        free(asteroid);
 }
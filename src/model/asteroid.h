@@ -2,32 +2,41 @@
 #define ASTEROID_H
 
 #include "model/object.h"
-#include "model/polygon.h"
+#include "model/shape.h"
 
+/**
+ * The description of a new asteroid, copied into an AsteroidStore to add it
+ * to the model.
+ */
 typedef struct {
     Object *object;
-    Array *polygon;
-    Array *verticies;
+    // The index of the asteroid's shape template.
+    int shape;
+    // The scale of the shape template.
+    double scale;
 } Asteroid;
 
 /**
- * @brief Create a new asteroid.
- */
-Asteroid *asteroid_create();
-
-/**
- * Advance the position of the asteroid.
+ * @brief Create a new asteroid with a random shape.
+ * 
+ * @param shapes The library to choose the shape from.
+ * @param asteroids The pool of Asteroid sized blocks to allocate the asteroid
+ * from, or NULL to allocate it on the heap.
+ * @param objects The pool of Object sized blocks to allocate the asteroid's
+ * object from, or NULL to allocate it on the heap.
  * 
- * @param asteroid The asteroid to advance.
+ * @returns Pointer to the asteroid, or NULL on failure.
  */
-void asteroid_advance(Asteroid *asteroid, double seconds);
+Asteroid *asteroid_create(ShapeLibrary *shapes, Pool *asteroids, Pool *objects);
 
 /**
  * @brief Deallocate memory previously allocated for an asteroid. Using the
  * asteroid after this call is undefined.
  * 
  * @param asteroid The asteroid to destroy.
+ * @param asteroids The pool the asteroid was allocated from, or NULL.
+ * @param objects The pool the asteroid's object was allocated from, or NULL.
  */
-void asteroid_destroy(Asteroid *asteroid);
+void asteroid_destroy(Asteroid *asteroid, Pool *asteroids, Pool *objects);
 
 #endif // ASTEROID_H
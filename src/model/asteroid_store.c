@@ -0,0 +1,320 @@
+#include "model/asteroid_store.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "util/typed_array.h"
+
+ARRAY_DEFINE(vertex_range_array, VertexRange)
+
+AsteroidStore *asteroid_store_create(ShapeLibrary *shapes)
+{
+    AsteroidStore *store = malloc(sizeof(AsteroidStore));
+    if (!store)
+        return NULL;
+
+    store->position = array_create(sizeof(Vector));
+    store->velocity = array_create(sizeof(Vector));
+    store->angle = array_create(sizeof(double));
+    store->omega = array_create(sizeof(double));
+    store->previous_position = array_create(sizeof(Vector));
+    store->previous_angle = array_create(sizeof(double));
+    store->shape = array_create(sizeof(int));
+    store->scale = array_create(sizeof(double));
+    store->radius = array_create(sizeof(double));
+    store->verticies = vertex_range_array_create();
+    store->edges = vertex_range_array_create();
+    store->vertex_pool = vertex_pool_create();
+    store->axis_pool = vertex_pool_create();
+    store->shapes = shapes;
+    store->handles = handle_table_create();
+    store->high_water = 0;
+
+    if (!store->position || !store->velocity || !store->angle ||
+        !store->omega || !store->previous_position ||
+        !store->previous_angle || !store->shape || !store->scale ||
+        !store->radius ||
+        !store->verticies || !store->edges || !store->vertex_pool ||
+        !store->axis_pool || !store->handles) {
+        asteroid_store_destroy(store);
+        return NULL;
+    }
+
+    return store;
+}
+
+/**
+ * Update the world space verticies and seperating axes of an asteroid from its
+ * shape template, scale, position and angle.
+ */
+static inline void asteroid_store_transform(AsteroidStore *store, int index)
+{
+    Vector position = *((Vector*)array_data(store->position) + index);
+    double angle = *((double*)array_data(store->angle) + index);
+    double scale = *((double*)array_data(store->scale) + index);
+    int shape = *((int*)array_data(store->shape) + index);
+
+    ShapeTemplate *template = shape_library_get(store->shapes, shape);
+
+    double c = cos(angle);
+    double s = sin(angle);
+
+    // Calculate the new verticies. Scale and rotate by the current angle in
+    // one step, and add the position offset.
+    VertexRange v = *((VertexRange*)array_data(store->verticies) + index);
+    Vector *local = shape_library_verticies(store->shapes)
+        + template->verticies.offset;
+    Vector *world = vertex_pool_data(store->vertex_pool) + v.offset;
+    for (int j = 0; j < v.count; j++) {
+        Vector vertex = vector_rot_cs(*(local + j), c * scale, s * scale);
+        *(world + j) = vector_add(vertex, position);
+    }
+
+    // Rotate the seperating axes by the same angle. Uniform scaling does not
+    // change their direction.
+    VertexRange e = *((VertexRange*)array_data(store->edges) + index);
+    Vector *normals = shape_library_normals(store->shapes)
+        + template->normals.offset;
+    Vector *axes = vertex_pool_data(store->axis_pool) + e.offset;
+    for (int j = 0; j < e.count; j++)
+        *(axes + j) = vector_rot_cs(*(normals + j), c, s);
+}
+
+bool asteroid_store_reserve(AsteroidStore *store, int capacity)
+{
+    // Reserve enough geometry for every asteroid to have the largest shape.
+    int verticies = 0;
+    int normals = 0;
+    for (int i = 0; i < shape_library_length(store->shapes); i++) {
+        ShapeTemplate *template = shape_library_get(store->shapes, i);
+        if (template->verticies.count > verticies)
+            verticies = template->verticies.count;
+        if (template->normals.count > normals)
+            normals = template->normals.count;
+    }
+
+    Array *columns[] = {
+        store->position, store->velocity, store->angle, store->omega,
+        store->previous_position, store->previous_angle, store->shape,
+        store->scale, store->radius, store->verticies, store->edges
+    };
+
+    for (int i = 0; i < (int)(sizeof(columns) / sizeof(*columns)); i++) {
+        if (!array_reserve(columns[i], capacity))
+            return false;
+    }
+
+    return vertex_pool_reserve(store->vertex_pool, capacity * verticies)
+        && vertex_pool_reserve(store->axis_pool, capacity * normals)
+        && handle_table_reserve(store->handles, capacity);
+}
+
+int asteroid_store_add(AsteroidStore *store, Asteroid *asteroid)
+{
+    int index = asteroid_store_length(store);
+
+    int shapes = shape_library_length(store->shapes);
+    if (asteroid->shape < 0 || asteroid->shape >= shapes)
+        return -1;
+
+    ShapeTemplate *template = shape_library_get(store->shapes, asteroid->shape);
+    double radius = template->radius * asteroid->scale;
+
+    VertexRange verticies = vertex_pool_allocate(
+        store->vertex_pool,
+        template->verticies.count
+    );
+    if (verticies.offset < 0)
+        return -1;
+
+    VertexRange edges = vertex_pool_allocate(
+        store->axis_pool,
+        template->normals.count
+    );
+    if (edges.offset < 0) {
+        vertex_pool_free(store->vertex_pool, verticies);
+        return -1;
+    }
+
+    Object *object = asteroid->object;
+    if (!array_push_back(store->position, &object->position) ||
+        !array_push_back(store->velocity, &object->velocity) ||
+        !array_push_back(store->angle, &object->angle) ||
+        !array_push_back(store->omega, &object->omega) ||
+        !array_push_back(store->previous_position, &object->position) ||
+        !array_push_back(store->previous_angle, &object->angle) ||
+        !array_push_back(store->shape, &asteroid->shape) ||
+        !array_push_back(store->scale, &asteroid->scale) ||
+        !array_push_back(store->radius, &radius) ||
+        !array_push_back(store->verticies, &verticies) ||
+        !array_push_back(store->edges, &edges) ||
+        handle_table_push(store->handles) == HANDLE_NULL) {
+
+        // Drop whichever fields were added so every array has one element
+        // per asteroid.
+        array_resize(store->position, index);
+        array_resize(store->velocity, index);
+        array_resize(store->angle, index);
+        array_resize(store->omega, index);
+        array_resize(store->previous_position, index);
+        array_resize(store->previous_angle, index);
+        array_resize(store->shape, index);
+        array_resize(store->scale, index);
+        array_resize(store->radius, index);
+        array_resize(store->verticies, index);
+        array_resize(store->edges, index);
+        vertex_pool_free(store->vertex_pool, verticies);
+        vertex_pool_free(store->axis_pool, edges);
+        return -1;
+    }
+
+    if (index + 1 > store->high_water)
+        store->high_water = index + 1;
+
+    asteroid_store_transform(store, index);
+    return index;
+}
+
+bool asteroid_store_remove(AsteroidStore *store, int index)
+{
+    int n = asteroid_store_length(store);
+    if (index < 0 || index >= n)
+        return false;
+
+    VertexRange verticies = *vertex_range_array_get(store->verticies, index);
+    VertexRange edges = *vertex_range_array_get(store->edges, index);
+
+    Array *columns[] = {
+        store->position, store->velocity, store->angle, store->omega,
+        store->previous_position, store->previous_angle, store->shape,
+        store->scale, store->radius, store->verticies, store->edges
+    };
+
+    // Move the last asteroid into the removed asteroid's place. Resize rather
+    // than erase, which would shrink the columns, so that asteroids coming and
+    // going does not touch the heap.
+    for (int i = 0; i < (int)(sizeof(columns) / sizeof(*columns)); i++) {
+        if (index != n - 1)
+            memcpy(
+                array_get(columns[i], index),
+                array_get(columns[i], n - 1),
+                columns[i]->size
+            );
+        array_resize(columns[i], n - 1);
+    }
+
+    handle_table_swap_remove(store->handles, index);
+
+    // Close the gaps left in the pools, and move down the ranges after them.
+    vertex_pool_free(store->vertex_pool, verticies);
+    vertex_pool_free(store->axis_pool, edges);
+
+    VertexRange *v = array_data(store->verticies);
+    VertexRange *e = array_data(store->edges);
+    for (int i = 0; i < n - 1; i++) {
+        *(v + i) = vertex_pool_compact_range(*(v + i), verticies);
+        *(e + i) = vertex_pool_compact_range(*(e + i), edges);
+    }
+
+    return true;
+}
+
+Handle asteroid_store_handle(AsteroidStore *store, int index)
+{
+    return handle_table_handle(store->handles, index);
+}
+
+int asteroid_store_index(AsteroidStore *store, Handle handle)
+{
+    return handle_table_index(store->handles, handle);
+}
+
+int asteroid_store_length(AsteroidStore *store)
+{
+    return array_length(store->position);
+}
+
+int asteroid_store_capacity(AsteroidStore *store)
+{
+    return store->position->capacity;
+}
+
+int asteroid_store_high_water(AsteroidStore *store)
+{
+    return store->high_water;
+}
+
+void asteroid_store_advance(AsteroidStore *store, double seconds)
+{
+    int n = asteroid_store_length(store);
+
+    Vector *position = array_data(store->position);
+    Vector *velocity = array_data(store->velocity);
+    double *angle = array_data(store->angle);
+    double *omega = array_data(store->omega);
+
+    // Integrate each field in its own pass.
+    for (int i = 0; i < n; i++)
+        *(position + i) = vector_add(
+            *(position + i),
+            vector_scale(*(velocity + i), seconds)
+        );
+
+    for (int i = 0; i < n; i++)
+        *(angle + i) += *(omega + i) * seconds;
+
+    for (int i = 0; i < n; i++)
+        asteroid_store_transform(store, i);
+}
+
+void asteroid_store_save(AsteroidStore *store)
+{
+    int n = asteroid_store_length(store);
+
+    memcpy(
+        array_data(store->previous_position),
+        array_data(store->position),
+        n * sizeof(Vector)
+    );
+
+    memcpy(
+        array_data(store->previous_angle),
+        array_data(store->angle),
+        n * sizeof(double)
+    );
+}
+
+Hull asteroid_store_hull(AsteroidStore *store, int index)
+{
+    VertexRange v = *vertex_range_array_get(store->verticies, index);
+    VertexRange e = *vertex_range_array_get(store->edges, index);
+
+    Hull hull = {
+        vertex_pool_data(store->vertex_pool) + v.offset, v.count,
+        vertex_pool_data(store->axis_pool) + e.offset, e.count
+    };
+    return hull;
+}
+
+void asteroid_store_destroy(AsteroidStore *store)
+{
+    if (!store)
+        return;
+
+    Array *columns[] = {
+        store->position, store->velocity, store->angle, store->omega,
+        store->previous_position, store->previous_angle, store->shape,
+        store->scale, store->radius, store->verticies, store->edges
+    };
+
+    for (int i = 0; i < (int)(sizeof(columns) / sizeof(*columns)); i++) {
+        if (columns[i])
+            array_destroy(columns[i]);
+    }
+
+    vertex_pool_destroy(store->vertex_pool);
+    vertex_pool_destroy(store->axis_pool);
+    handle_table_destroy(store->handles);
+
+    free(store);
+}
@@ -0,0 +1,197 @@
+#ifndef ASTEROID_STORE_H
+#define ASTEROID_STORE_H
+
+#include "util/array.h"
+#include "util/handle.h"
+#include "util/vector.h"
+#include "model/asteroid.h"
+#include "model/polygon.h"
+#include "model/shape.h"
+#include "model/vertex_pool.h"
+
+/**
+ * Every asteroid of the model, stored as a structure of arrays. Each field of
+ * every asteroid is kept contiguously in its own array, indexed by asteroid,
+ * so passes over one field stream linearly through memory rather than
+ * chasing a pointer per asteroid.
+ * 
+ * An asteroid's local space geometry is a scaled shape template, which is
+ * shared with every other asteroid of the same shape. Only the world space
+ * geometry collision detection needs is kept per asteroid, in vertex pools
+ * that each asteroid refers to by range. Removing an asteroid moves the last
+ * asteroid into its place and compacts the pools, so every array stays dense.
+ * No buffer is ever shrunk, so once the store has been reserved for, or has
+ * grown to, its peak number of asteroids, adding and removing asteroids
+ * touches the heap no more.
+ * 
+ * Since removing renumbers asteroids, each asteroid also has a handle, which
+ * keeps referring to it until it is removed and can be looked up in constant
+ * time.
+ * 
+ * An asteroid takes 120 bytes besides its geometry: 48 for its motion, 24 for
+ * its motion before the last step, 20 for its template, scale and radius, 16
+ * for its vertex ranges and 12 for its handle. Its world space geometry takes
+ * 96 bytes more for a triangle or square and 160 for a pentagon. The geometry
+ * is kept rather than transformed into scratch memory on every increment so
+ * that collision detection reads it from one dense buffer, and the radius is
+ * cached since the bounding circle test reads it for every candidate pair.
+ */
+typedef struct {
+    // The position, velocity, angle and angular velocity of each asteroid, an
+    // Array of Vector, Vector, double and double respectively.
+    Array *position;
+    Array *velocity;
+    Array *angle;
+    Array *omega;
+    // The position and angle of each asteroid when the store was last saved,
+    // for interpolating between steps, an Array of Vector and double.
+    Array *previous_position;
+    Array *previous_angle;
+    // The shape template index and scale of each asteroid, an Array of int
+    // and double respectively.
+    Array *shape;
+    Array *scale;
+    // Radius of the circle about each asteroid's position containing its
+    // polygon, being its template's radius scaled, an Array of double.
+    Array *radius;
+    // The range of each asteroid's verticies in the vertex pool, and of its
+    // seperating axes in the axis pool, Arrays of VertexRange.
+    Array *verticies;
+    Array *edges;
+    // The world space verticies of every asteroid, updated on every advance.
+    VertexPool *vertex_pool;
+    // The world space seperating axes of every asteroid, rotated on every
+    // advance.
+    VertexPool *axis_pool;
+    // The shape templates. Not owned by the store.
+    ShapeLibrary *shapes;
+    // The handle of each asteroid, and the index of each handle's asteroid.
+    HandleTable *handles;
+    // The most asteroids that have been in the store at once.
+    int high_water;
+} AsteroidStore;
+
+/**
+ * Create a new empty asteroid store.
+ * 
+ * @param shapes The shape templates of the asteroids, which must outlive the
+ * store and must not change while asteroids use them.
+ * 
+ * @returns Pointer to the store, or NULL on failure.
+ */
+AsteroidStore *asteroid_store_create(ShapeLibrary *shapes);
+
+/**
+ * Grow the store until it has capacity for a number of asteroids of any
+ * shape, such that that many can be added without touching the heap.
+ * 
+ * @param store The store.
+ * @param capacity The number of asteroids to have capacity for.
+ * 
+ * @returns True on success, false on failure to allocate.
+ */
+bool asteroid_store_reserve(AsteroidStore *store, int capacity);
+
+/**
+ * Add an asteroid to the store, copying its state.
+ * 
+ * @param store The store.
+ * @param asteroid The asteroid to copy. Not referenced after the call.
+ * 
+ * @returns The index of the asteroid in the store, or -1 on failure.
+ */
+int asteroid_store_add(AsteroidStore *store, Asteroid *asteroid);
+
+/**
+ * Remove an asteroid from the store. The last asteroid is moved into its
+ * index, and the geometry after the asteroid's is moved down to fill the gap.
+ * 
+ * @param store The store.
+ * @param index The index of the asteroid to remove.
+ * 
+ * @returns True on success, false if the index is out of range.
+ */
+bool asteroid_store_remove(AsteroidStore *store, int index);
+
+/**
+ * Get the handle of an asteroid, which refers to it for as long as it is in
+ * the store, however it is renumbered.
+ * 
+ * @param store The store.
+ * @param index The index of the asteroid.
+ * 
+ * @returns The handle of the asteroid, or HANDLE_NULL if out of range.
+ */
+Handle asteroid_store_handle(AsteroidStore *store, int index);
+
+/**
+ * Get the current index of the asteroid a handle refers to.
+ * 
+ * @param store The store.
+ * @param handle The handle of the asteroid.
+ * 
+ * @returns The index of the asteroid, or -1 if it has been removed.
+ */
+int asteroid_store_index(AsteroidStore *store, Handle handle);
+
+/**
+ * Get the number of asteroids in the store.
+ * 
+ * @param store The store.
+ * @returns The number of asteroids.
+ */
+int asteroid_store_length(AsteroidStore *store);
+
+/**
+ * Get the number of asteroids the store can hold before it grows.
+ * 
+ * @param store The store.
+ * @returns The number of asteroids.
+ */
+int asteroid_store_capacity(AsteroidStore *store);
+
+/**
+ * Get the most asteroids that have been in the store at once.
+ * 
+ * @param store The store.
+ * @returns The number of asteroids.
+ */
+int asteroid_store_high_water(AsteroidStore *store);
+
+/**
+ * Advance every asteroid by its velocity and angular velocity over a period
+ * of time, and update their world space verticies and seperating axes.
+ * 
+ * @param store The store.
+ * @param seconds The number of seconds that have elapsed.
+ */
+void asteroid_store_advance(AsteroidStore *store, double seconds);
+
+/**
+ * Remember the current position and angle of every asteroid as its previous
+ * state, which drawing interpolates from.
+ * 
+ * @param store The store.
+ */
+void asteroid_store_save(AsteroidStore *store);
+
+/**
+ * Get the hull of an asteroid's world space polygon for collision detection.
+ * The hull refers to the store's buffers and is valid until an asteroid is
+ * next added or removed.
+ * 
+ * @param store The store.
+ * @param index The index of the asteroid.
+ * 
+ * @returns The asteroid's hull.
+ */
+Hull asteroid_store_hull(AsteroidStore *store, int index);
+
+/**
+ * Deallocate an asteroid store. Using the store after this call is undefined.
+ * 
+ * @param store The store to destroy.
+ */
+void asteroid_store_destroy(AsteroidStore *store);
+
+#endif // ASTEROID_STORE_H
@@ -0,0 +1,24 @@
+#include "model/broadphase.h"
+
+int pair_compare(const void *a, const void *b)
+{
+    const Pair *p = a;
+    const Pair *q = b;
+
+    if (p->a != q->a)
+        return p->a < q->a ? -1 : 1;
+    if (p->b != q->b)
+        return p->b < q->b ? -1 : 1;
+
+    return 0;
+}
+
+void broad_phase_brute_force(int n, Array *pairs)
+{
+    // Each unordered pair is added once.
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            pair_array_push_back(pairs, (Pair){i, j});
+        }
+    }
+}
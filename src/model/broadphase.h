@@ -0,0 +1,93 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <stdint.h>
+
+#include "util/array.h"
+#include "util/typed_array.h"
+
+/**
+ * An unordered pair of bodies, identified by their index in the model. The
+ * lower index is always stored in a.
+ */
+typedef struct {
+    int a; // The lower index of the pair.
+    int b; // The higher index of the pair.
+} Pair;
+
+// Typed functions for an Array of Pair, prefixed pair_array_.
+ARRAY_DEFINE(pair_array, Pair)
+
+/**
+ * The broad phase algorithms that can be used to find the candidate pairs of
+ * bodies that are passed on to the narrow phase.
+ */
+typedef enum {
+    // Every pair of bodies is a candidate. O(n^2).
+    BROAD_PHASE_BRUTE_FORCE,
+    // Bodies are bucketed into a uniform spatial hash grid, and only bodies in
+    // the same or neighbouring cells are candidates.
+    BROAD_PHASE_GRID,
+    // Bodies are kept sorted along the x axis between increments, and only
+    // bodies whose x extents overlap are candidates.
+    BROAD_PHASE_SWEEP,
+    // Bodies are leaves of a dynamic bounding volume hierarchy, which is
+    // queried with each body's box. Suits bodies of very different sizes.
+    BROAD_PHASE_TREE
+} BroadPhase;
+
+/**
+ * Create a pair from two body indicies, ordering them such that the lower
+ * index is first.
+ * 
+ * @param a The first body index.
+ * @param b The second body index.
+ * 
+ * @return The ordered pair.
+ */
+static inline Pair pair_create(int a, int b)
+{
+    Pair pair = {a < b ? a : b, a < b ? b : a};
+    return pair;
+}
+
+/**
+ * Pack a pair into a single key, for use with HashMap.
+ * 
+ * @param pair The pair.
+ * 
+ * @return The key uniquely identifying the pair.
+ */
+static inline uint64_t pair_key(Pair pair)
+{
+    return ((uint64_t)(uint32_t)pair.a << 32) | (uint32_t)pair.b;
+}
+
+/**
+ * Unpack a pair from a key created with pair_key().
+ * 
+ * @param key The key.
+ * 
+ * @return The pair identified by the key.
+ */
+static inline Pair pair_from_key(uint64_t key)
+{
+    Pair pair = {(int)(uint32_t)(key >> 32), (int)(uint32_t)key};
+    return pair;
+}
+
+/**
+ * Comparison function for sorting pairs with qsort(), ordering by the first
+ * index then by the second.
+ */
+int pair_compare(const void *a, const void *b);
+
+/**
+ * Find candidate pairs by pairing every body with every other body. 
+ * 
+ * @param n The number of bodies.
+ * @param pairs The Array of Pair to append the candidate pairs to.
+ */
+void broad_phase_brute_force(int n, Array *pairs);
+
+#endif // BROADPHASE_H
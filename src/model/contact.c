@@ -0,0 +1,135 @@
+#include "model/contact.h"
+
+#include "util/hashmap.h"
+#include "util/typed_array.h"
+
+ARRAY_DEFINE(contact_array, Contact)
+ARRAY_DEFINE(contact_event_array, ContactEvent)
+
+struct Contacts {
+    // The contacts of the current and previous increments.
+    Array *current;
+    Array *previous;
+    // The handle pairs of the previous contacts that have not been found
+    // again this increment, keyed by handle_pair_key().
+    HashMap *remaining;
+    Array *events;
+};
+
+Contacts *contacts_create()
+{
+    Contacts *contacts = malloc(sizeof(Contacts));
+    if (!contacts)
+        return NULL;
+
+    contacts->current = contact_array_create();
+    contacts->previous = contact_array_create();
+    contacts->remaining = hashmap_create(0);
+    contacts->events = contact_event_array_create();
+
+    if (!contacts->current || !contacts->previous ||
+        !contacts->remaining || !contacts->events) {
+        contacts_destroy(contacts);
+        return NULL;
+    }
+
+    return contacts;
+}
+
+bool contacts_begin(Contacts *contacts)
+{
+    Array *previous = contacts->previous;
+    contacts->previous = contacts->current;
+    contacts->current = previous;
+
+    array_resize(contacts->current, 0);
+    array_resize(contacts->events, 0);
+
+    // Every previous contact ends unless it is added again.
+    hashmap_clear(contacts->remaining);
+
+    Contact *contact = array_data(contacts->previous);
+    for (int i = 0; i < array_length(contacts->previous); i++) {
+        uint64_t key = handle_pair_key(contact[i].a, contact[i].b);
+        if (!hashmap_insert(contacts->remaining, key, NULL))
+            return false;
+    }
+
+    return true;
+}
+
+bool contacts_add(
+    Contacts *contacts,
+    Pair pair,
+    Handle a,
+    Handle b,
+    Collision *collision
+) {
+    Contact contact = {pair, a, b, collision->mtv, collision->toi};
+    return contact_array_push_back(contacts->current, contact);
+}
+
+bool contacts_end(Contacts *contacts)
+{
+    Contact *current = array_data(contacts->current);
+    Contact *previous = array_data(contacts->previous);
+
+    for (int i = 0; i < array_length(contacts->current); i++) {
+        uint64_t key = handle_pair_key(current[i].a, current[i].b);
+        ContactEvent event = {
+            hashmap_erase(contacts->remaining, key)
+                ? CONTACT_PERSIST
+                : CONTACT_BEGIN,
+            current[i]
+        };
+
+        if (!contact_event_array_push_back(contacts->events, event))
+            return false;
+    }
+
+    // The previous contacts that were not found again have ended.
+    for (int i = 0; i < array_length(contacts->previous); i++) {
+        uint64_t key = handle_pair_key(previous[i].a, previous[i].b);
+        if (!hashmap_contains(contacts->remaining, key))
+            continue;
+
+        ContactEvent event = {CONTACT_END, previous[i]};
+        if (!contact_event_array_push_back(contacts->events, event))
+            return false;
+    }
+
+    return true;
+}
+
+void contacts_reset(Contacts *contacts)
+{
+    array_resize(contacts->current, 0);
+    array_resize(contacts->previous, 0);
+    hashmap_clear(contacts->remaining);
+}
+
+Array *contacts_current(Contacts *contacts)
+{
+    return contacts->current;
+}
+
+Array *contacts_events(Contacts *contacts)
+{
+    return contacts->events;
+}
+
+void contacts_destroy(Contacts *contacts)
+{
+    if (!contacts)
+        return;
+
+    if (contacts->current)
+        array_destroy(contacts->current);
+    if (contacts->previous)
+        array_destroy(contacts->previous);
+    hashmap_destroy(contacts->remaining);
+    if (contacts->events)
+        array_destroy(contacts->events);
+
+    free(contacts);
+}
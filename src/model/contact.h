@@ -0,0 +1,141 @@
+#ifndef CONTACT_H
+#define CONTACT_H
+
+#include <stdbool.h>
+
+#include "util/array.h"
+#include "util/handle.h"
+#include "util/vector.h"
+#include "model/broadphase.h"
+#include "model/sat.h"
+
+/**
+ * A pair of bodies found colliding.
+ */
+typedef struct {
+    // The colliding bodies. Must be first so that pair_compare() can sort
+    // contacts.
+    Pair pair;
+    // The handles of the bodies of the pair, which keep referring to the same
+    // bodies when they are renumbered. Contacts are matched between increments
+    // by handle.
+    Handle a;
+    Handle b;
+    // The translation of the first body that seperates it from the second.
+    Vector mtv;
+    // The fraction of the increment at which the bodies first touched.
+    double toi;
+} Contact;
+
+/**
+ * The ways a contact can change between increments.
+ */
+typedef enum {
+    // The pair started colliding this increment.
+    CONTACT_BEGIN,
+    // The pair was colliding last increment and still is.
+    CONTACT_PERSIST,
+    // The pair was colliding last increment and no longer is.
+    CONTACT_END
+} ContactEventType;
+
+/**
+ * A change to a contact between increments.
+ */
+typedef struct {
+    ContactEventType type;
+    // The contact of this increment, or of the last increment if it ended.
+    Contact contact;
+} ContactEvent;
+
+/**
+ * The colliding pairs of the current increment, and the events derived by
+ * comparing them with the colliding pairs of the previous increment.
+ */
+typedef struct Contacts Contacts;
+
+/**
+ * Create a new empty set of contacts.
+ * 
+ * @returns Pointer to the contacts, or NULL on failure.
+ */
+Contacts *contacts_create();
+
+/**
+ * Start a new increment. The current contacts become the previous contacts,
+ * and the current contacts and events are cleared.
+ * 
+ * @param contacts The contacts.
+ * 
+ * @returns True on success, false on failure to allocate, in which case
+ * contacts may still be added but contacts_end() must not be called, as
+ * previous contacts that persist would be reported as beginning and would
+ * never end.
+ */
+bool contacts_begin(Contacts *contacts);
+
+/**
+ * Add a colliding pair to the current increment. Each pair must only be added
+ * once per increment.
+ * 
+ * @param contacts The contacts.
+ * @param pair The colliding pair.
+ * @param a The handle of the first body of the pair.
+ * @param b The handle of the second body of the pair.
+ * @param collision The result of the collision test of the pair.
+ * 
+ * @returns True on success, false on failure to allocate.
+ */
+bool contacts_add(
+    Contacts *contacts,
+    Pair pair,
+    Handle a,
+    Handle b,
+    Collision *collision
+);
+
+/**
+ * Finish the increment, generating a begin or persist event for every current
+ * contact and an end event for every previous contact that is no longer
+ * colliding, in that order.
+ * 
+ * @param contacts The contacts.
+ * 
+ * @returns True on success, false on failure to allocate, in which case the
+ * events are incomplete.
+ */
+bool contacts_end(Contacts *contacts);
+
+/**
+ * Forget every contact, such that every contact added next increment begins.
+ * 
+ * @param contacts The contacts.
+ */
+void contacts_reset(Contacts *contacts);
+
+/**
+ * Get the contacts of the current increment.
+ * 
+ * @param contacts The contacts.
+ * 
+ * @returns Array of Contact, valid until the next contacts_begin().
+ */
+Array *contacts_current(Contacts *contacts);
+
+/**
+ * Get the events of the current increment.
+ * 
+ * @param contacts The contacts.
+ * 
+ * @returns Array of ContactEvent, valid until the next contacts_begin().
+ */
+Array *contacts_events(Contacts *contacts);
+
+/**
+ * Deallocate contacts. Using the contacts after this call is undefined.
+ * 
+ * @param contacts The contacts to destroy.
+ */
+void contacts_destroy(Contacts *contacts);
+
+#endif // CONTACT_H
@@ -0,0 +1,411 @@
+#include "model/gjk.h"
+
+// A point of the Minkowski difference B - A, and the verticies forming it.
+typedef struct {
+    Vector w;
+    int a;
+    int b;
+    // Barycentric coordinate of the closest point on the simplex.
+    double u;
+} GjkVertex;
+
+static inline double cross(Vector a, Vector b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+static int gjk_support(Hull *hull, Vector d)
+{
+    // The vertex furthest in direction d.
+    int best = 0;
+    double best_dot = vector_dot(hull->verticies[0], d);
+    for (int i = 1; i < hull->n; i++) {
+        double dot = vector_dot(hull->verticies[i], d);
+        if (dot > best_dot) {
+            best = i;
+            best_dot = dot;
+        }
+    }
+    return best;
+}
+
+static GjkVertex gjk_vertex(Hull *A, Hull *B, int a, int b)
+{
+    GjkVertex v = {vector_sub(B->verticies[b], A->verticies[a]), a, b, 1.0};
+    return v;
+}
+
+static void gjk_solve2(GjkVertex *v, int *count)
+{
+    // Find the closest point to the origin on the segment v[0] v[1], reducing
+    // the simplex to the closest vertex if it is at an end.
+    Vector w1 = v[0].w;
+    Vector w2 = v[1].w;
+    Vector e12 = vector_sub(w2, w1);
+
+    double d12_2 = -vector_dot(w1, e12);
+    if (d12_2 <= 0.0) {
+        v[0].u = 1.0;
+        *count = 1;
+        return;
+    }
+
+    double d12_1 = vector_dot(w2, e12);
+    if (d12_1 <= 0.0) {
+        v[0] = v[1];
+        v[0].u = 1.0;
+        *count = 1;
+        return;
+    }
+
+    double inv = 1.0 / (d12_1 + d12_2);
+    v[0].u = d12_1 * inv;
+    v[1].u = d12_2 * inv;
+    *count = 2;
+}
+
+static void gjk_solve3(GjkVertex *v, int *count)
+{
+    // Find the closest point to the origin on the triangle v[0] v[1] v[2],
+    // reducing the simplex to the closest feature.
+    Vector w1 = v[0].w;
+    Vector w2 = v[1].w;
+    Vector w3 = v[2].w;
+
+    Vector e12 = vector_sub(w2, w1);
+    double d12_1 = vector_dot(w2, e12);
+    double d12_2 = -vector_dot(w1, e12);
+
+    Vector e13 = vector_sub(w3, w1);
+    double d13_1 = vector_dot(w3, e13);
+    double d13_2 = -vector_dot(w1, e13);
+
+    Vector e23 = vector_sub(w3, w2);
+    double d23_1 = vector_dot(w3, e23);
+    double d23_2 = -vector_dot(w2, e23);
+
+    double n123 = cross(e12, e13);
+    double d123_1 = n123 * cross(w2, w3);
+    double d123_2 = n123 * cross(w3, w1);
+    double d123_3 = n123 * cross(w1, w2);
+
+    // Vertex 1.
+    if (d12_2 <= 0.0 && d13_2 <= 0.0) {
+        v[0].u = 1.0;
+        *count = 1;
+        return;
+    }
+
+    // Edge 12.
+    if (d12_1 > 0.0 && d12_2 > 0.0 && d123_3 <= 0.0) {
+        double inv = 1.0 / (d12_1 + d12_2);
+        v[0].u = d12_1 * inv;
+        v[1].u = d12_2 * inv;
+        *count = 2;
+        return;
+    }
+
+    // Edge 13.
+    if (d13_1 > 0.0 && d13_2 > 0.0 && d123_2 <= 0.0) {
+        double inv = 1.0 / (d13_1 + d13_2);
+        v[0].u = d13_1 * inv;
+        v[1] = v[2];
+        v[1].u = d13_2 * inv;
+        *count = 2;
+        return;
+    }
+
+    // Vertex 2.
+    if (d12_1 <= 0.0 && d23_2 <= 0.0) {
+        v[0] = v[1];
+        v[0].u = 1.0;
+        *count = 1;
+        return;
+    }
+
+    // Vertex 3.
+    if (d13_1 <= 0.0 && d23_1 <= 0.0) {
+        v[0] = v[2];
+        v[0].u = 1.0;
+        *count = 1;
+        return;
+    }
+
+    // Edge 23.
+    if (d23_1 > 0.0 && d23_2 > 0.0 && d123_1 <= 0.0) {
+        double inv = 1.0 / (d23_1 + d23_2);
+        v[0] = v[2];
+        v[0].u = d23_2 * inv;
+        v[1].u = d23_1 * inv;
+        *count = 2;
+        return;
+    }
+
+    // The origin is inside the triangle.
+    double inv = 1.0 / (d123_1 + d123_2 + d123_3);
+    v[0].u = d123_1 * inv;
+    v[1].u = d123_2 * inv;
+    v[2].u = d123_3 * inv;
+    *count = 3;
+}
+
+static Vector gjk_closest(GjkVertex *v, int count)
+{
+    Vector p = vector_scale(v[0].w, v[0].u);
+    for (int i = 1; i < count; i++)
+        p = vector_add(p, vector_scale(v[i].w, v[i].u));
+    return p;
+}
+
+static void gjk_remove(Vector *polytope, int *n, int index)
+{
+    for (int i = index; i < *n - 1; i++)
+        polytope[i] = polytope[i + 1];
+    (*n)--;
+}
+
+static Vector gjk_epa(Hull *A, Hull *B, GjkVertex *simplex)
+{
+    // Expand the triangle containing the origin towards the boundary of the
+    // Minkowski difference, until the edge closest to the origin is on the
+    // boundary. The closest boundary point is the translation of A that
+    // moves the difference off the origin.
+    Vector polytope[GJK_POLYTOPE];
+    int n = 3;
+
+    polytope[0] = simplex[0].w;
+    polytope[1] = simplex[1].w;
+    polytope[2] = simplex[2].w;
+
+    // Wind the polytope counter clockwise so edge normals point outwards.
+    Vector ab = vector_sub(polytope[1], polytope[0]);
+    Vector ac = vector_sub(polytope[2], polytope[0]);
+    if (cross(ab, ac) < 0.0) {
+        Vector t = polytope[1];
+        polytope[1] = polytope[2];
+        polytope[2] = t;
+    }
+
+    Vector closest = {0.0, 0.0};
+
+    for (int iteration = 0; iteration < A->n + B->n + 3; iteration++) {
+
+        // Find the edge closest to the origin.
+        int edge = -1;
+        double distance = 0.0;
+        Vector normal = {0.0, 0.0};
+
+        for (int i = 0; i < n; i++) {
+            Vector e = vector_sub(polytope[(i + 1) % n], polytope[i]);
+            double length = vector_mag(e);
+            if (length < GJK_EPSILON)
+                continue;
+
+            Vector outward = {e.y / length, -e.x / length};
+            double d = vector_dot(outward, polytope[i]);
+            if (edge < 0 || d < distance) {
+                edge = i;
+                distance = d;
+                normal = outward;
+            }
+        }
+
+        if (edge < 0)
+            break;
+
+        closest = vector_scale(normal, distance);
+
+        // Stop if the furthest point of the difference along the normal is
+        // on the edge, as the edge is then on the boundary.
+        int a = gjk_support(A, vector_scale(normal, -1.0));
+        int b = gjk_support(B, normal);
+        Vector w = vector_sub(B->verticies[b], A->verticies[a]);
+
+        if (vector_dot(w, normal) - distance < GJK_EPSILON || n == GJK_POLYTOPE)
+            break;
+
+        // Insert the new point into the polytope after the edge.
+        int k = edge + 1;
+        for (int i = n; i > k; i--)
+            polytope[i] = polytope[i - 1];
+        polytope[k] = w;
+        n++;
+
+        // Points of the starting triangle need not be on the boundary, so
+        // the new point can leave its neighbours inside the polytope. Remove
+        // them to keep it convex, which only grows it.
+        while (n > 3) {
+            int before = (k - 1 + n) % n;
+            Vector a = polytope[(k - 2 + n) % n];
+            Vector in = vector_sub(polytope[before], a);
+            Vector out = vector_sub(w, polytope[before]);
+            if (cross(in, out) > 0.0)
+                break;
+            gjk_remove(polytope, &n, before);
+            if (before < k)
+                k--;
+        }
+
+        while (n > 3) {
+            int after = (k + 1) % n;
+            Vector b = polytope[(k + 2) % n];
+            Vector in = vector_sub(polytope[after], w);
+            Vector out = vector_sub(b, polytope[after]);
+            if (cross(in, out) > 0.0)
+                break;
+            gjk_remove(polytope, &n, after);
+            if (after < k)
+                k--;
+        }
+    }
+
+    return closest;
+}
+
+static bool gjk_complete(Hull *A, Hull *B, GjkVertex *v, int *count)
+{
+    // The origin is on the segment or point of the simplex. Try to extend the
+    // simplex to a triangle containing the origin on either side of the
+    // segment. If neither side extends, the difference is flat and the hulls
+    // are only touching.
+    if (*count == 1)
+        return false;
+
+    Vector e = vector_sub(v[1].w, v[0].w);
+    Vector normals[2] = {{-e.y, e.x}, {e.y, -e.x}};
+
+    for (int i = 0; i < 2; i++) {
+        int a = gjk_support(A, vector_scale(normals[i], -1.0));
+        int b = gjk_support(B, normals[i]);
+        GjkVertex w = gjk_vertex(A, B, a, b);
+
+        if (vector_dot(w.w, normals[i]) > GJK_EPSILON * vector_mag(e)) {
+            v[2] = w;
+            *count = 3;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool gjk_colliding(Hull *A, Hull *B, Simplex *simplex, Collision *result)
+{
+    if (A->n < 1 || B->n < 1)
+        return false;
+
+    GjkVertex v[3];
+    int count = 0;
+
+    // Rebuild the cached simplex from the hulls' current verticies, ignoring
+    // it if the hulls have changed shape.
+    for (int i = 0; i < simplex->count && i < 3; i++) {
+        if (simplex->a[i] >= A->n || simplex->b[i] >= B->n) {
+            count = 0;
+            break;
+        }
+        v[count++] = gjk_vertex(A, B, simplex->a[i], simplex->b[i]);
+    }
+
+    if (count == 0)
+        v[count++] = gjk_vertex(A, B, 0, 0);
+
+    int iterations = 0;
+    int maximum = 20 + A->n + B->n;
+
+    // Whether the loop stopped on an answer rather than running out of
+    // iterations.
+    bool converged = false;
+
+    while (iterations < maximum) {
+
+        // Remember the simplex to detect when no progress is made.
+        int saved_a[3];
+        int saved_b[3];
+        int saved = count;
+        for (int i = 0; i < count; i++) {
+            saved_a[i] = v[i].a;
+            saved_b[i] = v[i].b;
+        }
+
+        // Reduce the simplex to the feature closest to the origin.
+        if (count == 2)
+            gjk_solve2(v, &count);
+        else if (count == 3)
+            gjk_solve3(v, &count);
+
+        // A triangle means the origin is inside the difference.
+        if (count == 3) {
+            converged = true;
+            break;
+        }
+
+        // Search towards the origin from the closest feature.
+        Vector d;
+        if (count == 1) {
+            d = vector_scale(v[0].w, -1.0);
+        }
+        else {
+            Vector e12 = vector_sub(v[1].w, v[0].w);
+            d = cross(e12, vector_scale(v[0].w, -1.0)) > 0.0
+                ? (Vector){-e12.y, e12.x}
+                : (Vector){e12.y, -e12.x};
+        }
+
+        // The origin is on the simplex.
+        if (vector_dot(d, d) < GJK_EPSILON * GJK_EPSILON) {
+            converged = true;
+            break;
+        }
+
+        GjkVertex w = gjk_vertex(
+            A, B,
+            gjk_support(A, vector_scale(d, -1.0)),
+            gjk_support(B, d)
+        );
+        iterations++;
+
+        // Stop if the new point is already in the simplex, as no progress can
+        // be made.
+        bool duplicate = false;
+        for (int i = 0; i < saved; i++)
+            duplicate = duplicate || (w.a == saved_a[i] && w.b == saved_b[i]);
+        if (duplicate) {
+            converged = true;
+            break;
+        }
+
+        v[count++] = w;
+    }
+
+    // Leave the answer to the caller if the closest point was not found.
+    if (!converged)
+        return false;
+
+    // Cache the final simplex for next time.
+    simplex->count = count;
+    for (int i = 0; i < count; i++) {
+        simplex->a[i] = v[i].a;
+        simplex->b[i] = v[i].b;
+    }
+
+    result->toi = 1.0;
+
+    if (count == 3) {
+        result->colliding = true;
+        result->mtv = gjk_epa(A, B, v);
+        return true;
+    }
+
+    // Otherwise the hulls are colliding only if the closest point of the
+    // difference is the origin.
+    Vector closest = gjk_closest(v, count);
+    double squared = vector_dot(closest, closest);
+    result->colliding = squared < GJK_EPSILON * GJK_EPSILON;
+    result->mtv = (Vector){0.0, 0.0};
+
+    if (result->colliding && gjk_complete(A, B, v, &count))
+        result->mtv = gjk_epa(A, B, v);
+
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef GJK_H
+#define GJK_H
+
+#include <stdbool.h>
+
+#include "util/vector.h"
+#include "model/polygon.h"
+#include "model/sat.h"
+
+// The most points the expanding polytope can have. The polytope of two
+// convex polygons never has more points than both polygons have verticies.
+#define GJK_POLYTOPE 256
+
+// Distances smaller than this are considered touching.
+#define GJK_EPSILON 1e-10
+
+/**
+ * A simplex of the Minkowski difference of two hulls, recorded as the indicies
+ * of the verticies of each hull whose difference forms each point. Storing
+ * indicies rather than points lets a simplex from one tick be rebuilt from
+ * the hulls' new verticies on the next, so GJK starts close to the answer.
+ * 
+ * A zeroed simplex is empty and is valid to pass to gjk_colliding().
+ */
+typedef struct {
+    // The vertex of the first hull of each point.
+    int a[3];
+    // The vertex of the second hull of each point.
+    int b[3];
+    // The number of points, from 0 to 3.
+    int count;
+} Simplex;
+
+/**
+ * Determine whether two hulls are colliding using the Gilbert-Johnson-Keerthi
+ * algorithm, and calculate the minimum translation vector with the expanding
+ * polytope algorithm if they are.
+ * 
+ * Unlike the seperating axis theorem, the cost of each iteration is linear in
+ * the number of verticies rather than the number of verticies times the
+ * number of axes, and only a few iterations are needed when starting from the
+ * previous tick's simplex.
+ * 
+ * @param A The first hull. Only its verticies are used.
+ * @param B The second hull. Only its verticies are used.
+ * @param simplex The simplex to start from, which is replaced by the final
+ * simplex to start from next time.
+ * @param result The result of the test. The MTV is the translation of A.
+ * 
+ * @returns True if the algorithm succeeded, otherwise false if the hulls are
+ * empty or it did not converge within its iteration limit, in which case the
+ * result is not set.
+ */
+bool gjk_colliding(Hull *A, Hull *B, Simplex *simplex, Collision *result);
+
+#endif // GJK_H
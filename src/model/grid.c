@@ -0,0 +1,201 @@
+#include "model/grid.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "model/broadphase.h"
+
+// The integer coordinates of a grid cell.
+typedef struct {
+    int x;
+    int y;
+} GridCell;
+
+struct Grid {
+    // The cell of each body, indexed by body.
+    GridCell *cells;
+    // The hash table bucket of each body, indexed by body.
+    int *buckets;
+    // Body indicies sorted by bucket.
+    int *entries;
+    // The number of bodies that there is space for in the above buffers.
+    int capacity;
+    // Index into entries at which each bucket starts. One longer than the
+    // table so that the end of each bucket is the start of the next.
+    int *starts;
+    // The number of buckets in the hash table. Always a power of 2.
+    int table;
+};
+
+Grid *grid_create()
+{
+    Grid *grid = malloc(sizeof(Grid));
+    if (!grid)
+        return NULL;
+
+    grid->cells = NULL;
+    grid->buckets = NULL;
+    grid->entries = NULL;
+    grid->capacity = 0;
+    grid->starts = NULL;
+    grid->table = 0;
+
+    return grid;
+}
+
+static bool grid_reserve(Grid *grid, int n)
+{
+    if (n <= grid->capacity)
+        return true;
+
+    // The hash table has at least twice as many buckets as bodies to keep the
+    // number of bodies sharing a bucket by chance low.
+    int table = 1;
+    while (table < 2 * n)
+        table <<= 1;
+
+    GridCell *cells = realloc(grid->cells, n * sizeof(GridCell));
+    if (cells)
+        grid->cells = cells;
+
+    int *buckets = realloc(grid->buckets, n * sizeof(int));
+    if (buckets)
+        grid->buckets = buckets;
+
+    int *entries = realloc(grid->entries, n * sizeof(int));
+    if (entries)
+        grid->entries = entries;
+
+    int *starts = realloc(grid->starts, (table + 1) * sizeof(int));
+    if (starts)
+        grid->starts = starts;
+
+    if (!cells || !buckets || !entries || !starts)
+        return false;
+
+    grid->capacity = n;
+    grid->table = table;
+
+    return true;
+}
+
+static inline int grid_hash(Grid *grid, int x, int y)
+{
+    // Large primes to spread neighbouring cells across the table.
+    uint32_t hash = ((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u);
+    return hash & (grid->table - 1);
+}
+
+bool grid_pairs(Grid *grid, AABB *bounds, int n, Array *pairs)
+{
+    if (n < 2)
+        return true;
+
+    if (!grid_reserve(grid, n))
+        return false;
+
+    // The cell size is the largest extent of any box, so that the centres of
+    // two overlapping boxes are never more than one cell apart.
+    double size = 0.0;
+    for (int i = 0; i < n; i++) {
+        double width = bounds[i].max.x - bounds[i].min.x;
+        double height = bounds[i].max.y - bounds[i].min.y;
+        if (width > size)
+            size = width;
+        if (height > size)
+            size = height;
+    }
+    if (size <= 0.0)
+        size = 1.0;
+
+    // Bucket each body by the cell of its centre, and count the number of
+    // bodies in each bucket.
+    int *starts = grid->starts;
+    memset(starts, 0, (grid->table + 1) * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        Vector centre = aabb_centre(bounds[i]);
+        GridCell cell = {floor(centre.x / size), floor(centre.y / size)};
+        int bucket = grid_hash(grid, cell.x, cell.y);
+
+        grid->cells[i] = cell;
+        grid->buckets[i] = bucket;
+        starts[bucket + 1]++;
+    }
+
+    // Convert the counts into the end of each bucket, then place each body
+    // into its bucket by decrementing the end. Once all bodies are placed,
+    // each bucket's end has been decremented down to its start.
+    for (int b = 0; b < grid->table; b++)
+        starts[b + 1] += starts[b];
+
+    for (int i = n; i-- > 0;) {
+        int bucket = grid->buckets[i];
+        grid->entries[--starts[bucket + 1]] = i;
+    }
+
+    // The start of bucket b is now at b + 1, so shift them back into place.
+    memmove(starts, starts + 1, grid->table * sizeof(int));
+    starts[grid->table] = n;
+
+    for (int i = 0; i < n; i++) {
+
+        GridCell cell = grid->cells[i];
+
+        // The buckets of the neighbouring cells that have already been
+        // searched. Distinct cells can hash to the same bucket, which must
+        // only be searched once to avoid reporting a pair twice.
+        int visited[9];
+        int n_visited = 0;
+
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+
+                int bucket = grid_hash(grid, cell.x + dx, cell.y + dy);
+
+                bool seen = false;
+                for (int k = 0; k < n_visited; k++)
+                    seen = seen || visited[k] == bucket;
+                if (seen)
+                    continue;
+                visited[n_visited++] = bucket;
+
+                for (int e = starts[bucket]; e < starts[bucket + 1]; e++) {
+                    int j = grid->entries[e];
+
+                    // Only report each unordered pair once.
+                    if (j <= i)
+                        continue;
+
+                    // Skip bodies that share the bucket by hash collision but
+                    // are not in a neighbouring cell.
+                    GridCell other = grid->cells[j];
+                    if (abs(other.x - cell.x) > 1 || abs(other.y - cell.y) > 1)
+                        continue;
+
+                    if (!aabb_overlap(bounds[i], bounds[j]))
+                        continue;
+
+                    Pair pair = {i, j};
+                    if (!pair_array_push_back(pairs, pair))
+                        return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void grid_destroy(Grid *grid)
+{
+    if (!grid)
+        return;
+
+    free(grid->cells);
+    free(grid->buckets);
+    free(grid->entries);
+    free(grid->starts);
+    free(grid);
+}
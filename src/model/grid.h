@@ -0,0 +1,45 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include "util/array.h"
+#include "model/aabb.h"
+
+/**
+ * A uniform grid spatial hash used as a broad phase. 
+ * 
+ * Each tick every body is bucketed by the cell containing the centre of its
+ * bounding box. The cell size is the largest bounding box extent, so any two
+ * overlapping boxes are always in the same or neighbouring cells, and only
+ * those bodies are compared. Cells are hashed into a table rather than stored
+ * densely, so the grid is unbounded.
+ */
+typedef struct Grid Grid;
+
+/**
+ * Create a new spatial hash grid.
+ * 
+ * @returns A pointer to the grid, or NULL on failure.
+ */
+Grid *grid_create();
+
+/**
+ * Bucket the provided bounding boxes into the grid and find all pairs of boxes
+ * in the same or neighbouring cells whose boxes overlap.
+ * 
+ * @param grid The grid to bucket the bodies into.
+ * @param bounds The bounding boxes of the bodies, indexed by body.
+ * @param n The number of bodies.
+ * @param pairs The Array of Pair to append the candidate pairs to.
+ * 
+ * @returns True on success, false on failure to allocate memory.
+ */
+bool grid_pairs(Grid *grid, AABB *bounds, int n, Array *pairs);
+
+/**
+ * Deallocate a grid. Using the grid after this call is undefined.
+ * 
+ * @param grid The grid to destroy.
+ */
+void grid_destroy(Grid *grid);
+
+#endif // GRID_H
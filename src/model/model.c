@@ -5,26 +5,145 @@
 
 #include "SDL2/SDL.h"
 
+#include "util/arena.h"
 #include "util/array.h"
 #include "util/random.h"
+#include "util/ring.h"
 #include "util/vector.h"
 #include "util/time.h"
 #include "util/intervalthread.h"
 #include "model/asteroid.h"
+#include "model/asteroid_store.h"
+#include "model/shape.h"
+#include "model/grid.h"
+#include "model/sweep.h"
+#include "model/tree.h"
+#include "model/sat.h"
+#include "model/gjk.h"
+#include "model/pair_cache.h"
+#include "model/contact.h"
+#include "model/snapshot.h"
 
 /**
  * Struct containing Model control related data.
  */
 struct Model {
-    Array *asteroids;
-    Array *colliding;
+    AsteroidStore *asteroids;
+    // The shape templates of the asteroids.
+    ShapeLibrary *shapes;
+    // Scratch memory for the arrays below that only live for one increment,
+    // reset at the start of each.
+    Arena *arena;
+    // Displacement of each asteroid over the last increment.
+    Array *displacements;
+    // Bounding box of each asteroid, swept over the last increment.
+    Array *bounds;
+    // Candidate pairs found by the broad phase.
+    Array *pairs;
+    // Hull of each asteroid, updated every increment.
+    Array *hulls;
+    // Candidate pairs whose bounding circles overlap, the axis to test first
+    // for each, and their results.
+    Array *narrow;
+    Array *axes;
+    Array *results;
+    // Pairs found colliding by the narrow phase, and how they changed since
+    // the last increment.
+    Contacts *contacts;
+    // Candidate and colliding pairs found by brute force when cross checking.
+    Array *check_pairs;
+    Contacts *check_contacts;
+    // The broad phase in use, and its data.
+    BroadPhase broad_phase;
+    Grid *grid;
+    SweepAndPrune *sweep;
+    AABBTree *tree;
+    // The tree proxy of each asteroid.
+    Array *proxies;
+    // Snapshots of the state at the end of each step for drawing, and a buffer
+    // of the interpolated verticies of the asteroid being drawn, which are
+    // only used by the view's thread.
+    SnapshotBuffer *snapshots;
+    Array *draw_verticies;
+    // The narrow phase in use, and the axis or simplex of each candidate pair.
+    NarrowPhase narrow_phase;
+    PairCache *cache;
+    bool cross_check;
+    ModelStatistics statistics;
     Time time_last;
+    // The number of steps simulated per second, and the time that has passed
+    // but not yet been simulated, in seconds.
+    int tick_rate;
+    double accumulator;
     SDL_mutex *mutex;
+    // Commands queued by the controller, performed at the start of each tick.
+    Ring *commands;
+    // Commands dropped because the queue was full, counted by the controller's
+    // thread without locking the model.
+    SDL_atomic_t dropped_commands;
     IntervalThread *thread;
     bool paused;
 };
 
+/**
+ * Get the number of milliseconds between wake ups of the model thread for a
+ * tick rate, being one step, but at least a millisecond.
+ */
+uint32_t model_wake_interval(int tick_rate)
+{
+    uint32_t interval = 1000 / tick_rate;
+    return interval > 0 ? interval : 1;
+}
+
 Model *model_create()
+{
+    Model *model = model_create_headless();
+    if (!model)
+        return NULL;
+
+    // Start the thread that advances the model in real time.
+    model->thread = interval_thread_create(
+        model_increment,
+        model,
+        model_wake_interval(model->tick_rate),
+        "Model"
+    );
+
+    if (!model->thread) {
+        model_destroy(model);
+        return NULL;
+    }
+
+    return model;
+}
+
+/**
+ * Create the shapes the asteroids are made from, being regular polygons of 3
+ * to 5 verticies.
+ * 
+ * @returns Pointer to the shapes, or NULL on failure.
+ */
+ShapeLibrary *model_create_shapes()
+{
+    ShapeLibrary *shapes = shape_library_create();
+    if (!shapes)
+        return NULL;
+
+    for (int n = 3; n <= 5; n++) {
+        Array *polygon = polygon_create_regular(n, 1);
+        int index = polygon ? shape_library_add(shapes, polygon) : -1;
+        array_destroy(polygon);
+
+        if (index < 0) {
+            shape_library_destroy(shapes);
+            return NULL;
+        }
+    }
+
+    return shapes;
+}
+
+Model *model_create_headless()
 {
     // Seed random for this thread.
     random_seed();
@@ -34,103 +153,726 @@ Model *model_create()
     if (!model)
         return NULL;
 
-    Array *asteroids = array_create(sizeof(Asteroid*));
-    Array *colliding = array_create(sizeof(bool));
+    model->shapes = model_create_shapes();
+    model->asteroids = model->shapes
+        ? asteroid_store_create(model->shapes)
+        : NULL;
+    model->arena = arena_create(MODEL_ARENA_SIZE, true);
+    model->displacements = NULL;
+    model->bounds = NULL;
+    model->pairs = NULL;
+    model->hulls = NULL;
+    model->narrow = NULL;
+    model->axes = NULL;
+    model->results = NULL;
+    model->contacts = contacts_create();
+    model->check_pairs = NULL;
+    model->check_contacts = contacts_create();
+    model->broad_phase = MODEL_BROAD_PHASE;
+    model->grid = grid_create();
+    model->sweep = sweep_create();
+    model->tree = aabb_tree_create();
+    model->proxies = array_create(sizeof(int));
+    model->snapshots = snapshot_buffer_create();
+    model->draw_verticies = array_create(sizeof(Vector));
+    model->narrow_phase = MODEL_NARROW_PHASE;
+    model->cache = pair_cache_create();
+    model->cross_check = MODEL_CROSS_CHECK;
+    model->statistics = (ModelStatistics){0};
+    model->time_last = time_global();
+    model->tick_rate = MODEL_TICK_RATE;
+    model->accumulator = 0.0;
+    model->paused = false;
+    model->mutex = SDL_CreateMutex();
+    model->commands = ring_create(sizeof(Command), MODEL_COMMAND_CAPACITY);
+    SDL_AtomicSet(&model->dropped_commands, 0);
+    model->thread = NULL;
 
-    for (int i = 0; i < 10; ++i) {
+    // Only the pair cache is optional, as without it each pair is tested
+    // from scratch. Without scratch memory there would be no collision
+    // detection at all.
+    if (!model->shapes || !model->asteroids || !model->arena ||
+        !model->contacts || !model->check_contacts || !model->grid ||
+        !model->sweep || !model->tree || !model->proxies ||
+        !model->snapshots || !model->draw_verticies || !model->mutex ||
+        !model->commands) {
+        model_destroy(model);
+        return NULL;
+    }
 
-        // Create an asteroid at a random location.
-        Asteroid *asteroid = asteroid_create();
-        asteroid->object->position = (Vector){
-            random_double(-5, 5),
-            random_double(-5, 5)
-        };
+    // Reserve the store for the asteroids up front, so that spawning and
+    // despawning up to that many does not touch the heap.
+    if (!asteroid_store_reserve(model->asteroids, MODEL_ASTEROIDS)) {
+        model_destroy(model);
+        return NULL;
+    }
 
-        asteroid->object->velocity = (Vector){
-            random_double(-0.03, 0.03),
-            random_double(-0.03, 0.03)
-        };
+    for (int i = 0; i < MODEL_ASTEROIDS; ++i) {
+        if (model_spawn(model) < 0) {
+            model_destroy(model);
+            return NULL;
+        }
+    }
 
-        asteroid->object->omega = random_double(-0.03, 0.03);
+    return model;
+}
 
-        // Add it to the array of asteroids.
-        array_push_back(asteroids, (void*)&asteroid);
+int model_spawn(Model *model)
+{
+    // Describe an asteroid at a random location on the stack, which the store
+    // copies into its columns.
+    Object object = {0};
+    Asteroid asteroid = {
+        &object,
+        random_int(0, shape_library_length(model->shapes) - 1),
+        1.0
+    };
+
+    object.position = (Vector){
+        random_double(-5, 5),
+        random_double(-5, 5)
+    };
+
+    object.velocity = (Vector){
+        random_double(-4.0, 4.0),
+        random_double(-4.0, 4.0)
+    };
+
+    object.omega = random_double(-4.0, 4.0);
+
+    int index = asteroid_store_add(model->asteroids, &asteroid);
+    if (index >= 0)
+        model->statistics.spawns++;
+
+    return index;
+}
+
+bool model_despawn(Model *model, int index)
+{
+    if (!asteroid_store_remove(model->asteroids, index))
+        return false;
+
+    model->statistics.despawns++;
+    return true;
+}
+
+bool model_respawn(Model *model)
+{
+    int n = asteroid_store_length(model->asteroids);
+    if (n > 0)
+        model_despawn(model, random_int(0, n - 1));
+
+    return model_spawn(model) >= 0;
+}
+
+/**
+ * Free the scratch arrays of the last increment and create them again in the
+ * model's arena.
+ * 
+ * @returns True on success, false if any array could not be allocated.
+ */
+bool model_scratch_create(Model *model)
+{
+    if (!model->arena)
+        return false;
 
-        // Initially set to not colliding.
-        bool t = false;
-        array_push_back(colliding, &t);
+    arena_reset(model->arena);
+
+    Arena *arena = model->arena;
+    model->displacements = array_create_arena(arena, sizeof(Vector));
+    model->bounds = array_create_arena(arena, sizeof(AABB));
+    model->pairs = array_create_arena(arena, sizeof(Pair));
+    model->hulls = array_create_arena(arena, sizeof(Hull));
+    model->narrow = array_create_arena(arena, sizeof(Pair));
+    model->axes = array_create_arena(arena, sizeof(int));
+    model->results = array_create_arena(arena, sizeof(Collision));
+    model->check_pairs = array_create_arena(arena, sizeof(Pair));
+
+    return model->displacements
+        && model->bounds
+        && model->pairs
+        && model->hulls
+        && model->narrow
+        && model->axes
+        && model->results
+        && model->check_pairs;
+}
+
+void model_update_bounds(Model *model)
+{
+    int n = asteroid_store_length(model->asteroids);
+
+    if (!array_resize(model->hulls, n) || !array_resize(model->bounds, n))
+        return;
+
+    Hull *hulls = array_data(model->hulls);
+    for (int i = 0; i < n; i++)
+        *(hulls + i) = asteroid_store_hull(model->asteroids, i);
+
+    AABB *bounds = array_data(model->bounds);
+    for (int i = 0; i < n; i++)
+        *(bounds + i) = polygon_bounds_hull(hulls + i);
+
+    // Sweep each box back over the asteroid's displacement so that the broad
+    // phase finds pairs that passed through each other during the increment.
+    if (array_length(model->displacements) == n) {
+        Vector *displacements = array_data(model->displacements);
+        for (int i = 0; i < n; i++) {
+            AABB end = *(bounds + i);
+            AABB start = {
+                vector_sub(end.min, *(displacements + i)),
+                vector_sub(end.max, *(displacements + i))
+            };
+            *(bounds + i) = aabb_union(start, end);
+        }
     }
+}
 
-    model->asteroids = asteroids;
-    model->colliding = colliding;
-    model->time_last = time_global();
-    model->paused = false;
-    model->mutex = SDL_CreateMutex();
-    model->thread = interval_thread_create(model_increment, model, 7, "Model");
+/**
+ * Context passed through aabb_tree_query() to collect the pairs of one body.
+ */
+typedef struct {
+    AABB *bounds;
+    int body;
+    Array *pairs;
+    bool failed;
+} ModelTreeQuery;
 
-    return model;
+bool model_tree_query(int data, void *context)
+{
+    ModelTreeQuery *query = context;
+
+    // Only report each unordered pair once, and only if the tight boxes
+    // overlap rather than just the fattened boxes in the tree.
+    if (data <= query->body)
+        return true;
+
+    if (!aabb_overlap(query->bounds[query->body], query->bounds[data]))
+        return true;
+
+    if (!pair_array_push_back(query->pairs, (Pair){query->body, data})) {
+        query->failed = true;
+        return false;
+    }
+
+    return true;
 }
 
-void model_increment(void *data)
+bool model_tree_pairs(Model *model, Array *pairs)
 {
-    Model *model = data;
+    AABB *bounds = array_data(model->bounds);
+    int n = asteroid_store_length(model->asteroids);
 
-    // Lock access to the model data and advance the model.
-    SDL_LockMutex(model->mutex);
+    // Rebuild the tree when asteroids are added or removed, otherwise move
+    // each leaf to its asteroid's new bounds.
+    if (array_length(model->proxies) != n) {
+        aabb_tree_clear(model->tree);
+
+        if (!array_resize(model->proxies, n))
+            return false;
+
+        int *proxies = array_data(model->proxies);
+        for (int i = 0; i < n; i++) {
+            *(proxies + i) = aabb_tree_insert(model->tree, *(bounds + i), i);
+            if (*(proxies + i) < 0) {
+                array_resize(model->proxies, 0);
+                return false;
+            }
+        }
+    }
+    else {
+        // Extend each leaf's fattened box along the asteroid's last
+        // displacement, predicting where it moves next.
+        int *proxies = array_data(model->proxies);
+        Vector *displacements = array_data(model->displacements);
+        bool moved = array_length(model->displacements) == n;
+        for (int i = 0; i < n; i++) {
+            aabb_tree_move(
+                model->tree,
+                *(proxies + i),
+                *(bounds + i),
+                moved ? *(displacements + i) : (Vector){0.0, 0.0}
+            );
+        }
+    }
 
-    Time elapsed_ms = time_since_last(&model->time_last);
+    ModelTreeQuery query = {bounds, 0, pairs, false};
+    for (int i = 0; i < n && !query.failed; i++) {
+        query.body = i;
+        aabb_tree_query(model->tree, *(bounds + i), model_tree_query, &query);
+    }
+
+    return !query.failed;
+}
+
+void model_broad_phase(Model *model, BroadPhase broad_phase, Array *pairs)
+{
+    int n = asteroid_store_length(model->asteroids);
+
+    // Clear the pairs from the last increment without freeing the buffer.
+    array_resize(pairs, 0);
+
+    switch (broad_phase)
+    {
+        case BROAD_PHASE_GRID: {
+            if (grid_pairs(model->grid, array_data(model->bounds), n, pairs))
+                break;
+
+            // Fall back to brute force if the grid failed to allocate.
+            array_resize(pairs, 0);
+            broad_phase_brute_force(n, pairs);
+            break;
+        }
+        case BROAD_PHASE_SWEEP: {
+            if (sweep_pairs(model->sweep, array_data(model->bounds), n, pairs))
+                break;
+
+            // Fall back to brute force if the sweep failed to allocate.
+            array_resize(pairs, 0);
+            broad_phase_brute_force(n, pairs);
+            break;
+        }
+        case BROAD_PHASE_TREE: {
+            if (model_tree_pairs(model, pairs))
+                break;
+
+            // Fall back to brute force if the tree failed to allocate.
+            array_resize(pairs, 0);
+            broad_phase_brute_force(n, pairs);
+            break;
+        }
+        case BROAD_PHASE_BRUTE_FORCE:
+        default: broad_phase_brute_force(n, pairs); break;
+    }
+}
+
+/**
+ * Get the pair cache entry of a pair, by the handles of its asteroids.
+ */
+PairCacheEntry *model_pair_cache_get(Model *model, Pair pair)
+{
+    return pair_cache_get(
+        model->cache,
+        asteroid_store_handle(model->asteroids, pair.a),
+        asteroid_store_handle(model->asteroids, pair.b)
+    );
+}
 
-    int n = array_length(model->asteroids);
+void model_gjk_batch(Model *model, Pair *pairs, int n, Collision *results)
+{
+    Hull *hulls = array_data(model->hulls);
 
     for (int i = 0; i < n; i++) {
 
-        Asteroid *asteroid = *(Asteroid**)array_get(model->asteroids, i);
+        // Start from the pair's simplex of the last increment, or from
+        // nothing if the pair is new or the cache failed to allocate.
+        Simplex cold = {0};
+        PairCacheEntry *entry = NULL;
+        if (model->cache)
+            entry = model_pair_cache_get(model, pairs[i]);
 
-        if (!model->paused)
-            asteroid_advance(asteroid, (double)elapsed_ms / 1000);
+        Simplex *simplex = entry ? &entry->simplex : &cold;
 
-        if (asteroid->object->position.x < -5)
-            asteroid->object->velocity.x *= -1.0;
+        Hull *A = hulls + pairs[i].a;
+        Hull *B = hulls + pairs[i].b;
+        if (gjk_colliding(A, B, simplex, results + i))
+            continue;
 
-        if (asteroid->object->position.x > 5)
-            asteroid->object->velocity.x *= -1.0;
+        // Fall back to the seperating axis test if GJK failed to converge.
+        *simplex = (Simplex){0};
+        sat_colliding_batch(hulls, pairs + i, 1, NULL, results + i);
+    }
+}
 
-        if (asteroid->object->position.y < -5)
-            asteroid->object->velocity.y *= -1.0;
+void model_sat_batch(
+    Model *model,
+    Pair *pairs,
+    int n,
+    Collision *results,
+    ModelStatistics *statistics
+) {
+    Hull *hulls = array_data(model->hulls);
 
-        if (asteroid->object->position.y > 5)
-            asteroid->object->velocity.y *= -1.0;
+    // Test without hints if there is nowhere to keep them.
+    if (!statistics || !model->cache || !array_resize(model->axes, n)) {
+        sat_colliding_batch(hulls, pairs, n, NULL, results);
+        return;
     }
 
-    // Determine collisions.
-    for (int i = 0; i < n; i++)
-        *(bool*)array_get(model->colliding, i) = false;
+    // Start each pair from the axis that decided it last increment.
+    int *axes = array_data(model->axes);
+    for (int i = 0; i < n; i++) {
+        PairCacheEntry *entry = model_pair_cache_get(model, pairs[i]);
+        *(axes + i) = entry ? entry->axis : -1;
+    }
+
+    sat_colliding_batch(hulls, pairs, n, axes, results);
 
+    // Count the pairs decided by the same axis as last increment, and
+    // remember the new axes.
     for (int i = 0; i < n; i++) {
+        PairCacheEntry *entry = model_pair_cache_get(model, pairs[i]);
+        if (!entry)
+            continue;
+
+        if (entry->axis >= 0 && entry->axis == *(axes + i))
+            statistics->axis_hits++;
+        else
+            statistics->axis_misses++;
+
+        entry->axis = *(axes + i);
+    }
+}
 
-        if (*(bool*)array_get(model->colliding, i))
+/**
+ * Get the displacement of asteroid a relative to asteroid b over the last
+ * increment.
+ * 
+ * @returns True if the pair moved further than the smaller asteroid's radius
+ * relative to each other, so could have passed through each other between
+ * increments.
+ */
+bool model_pair_fast(Model *model, Pair pair, Vector *displacement)
+{
+    *displacement = (Vector){0.0, 0.0};
+    int n = asteroid_store_length(model->asteroids);
+    if (array_length(model->displacements) != n)
+        return false;
+
+    double *radius = array_data(model->asteroids->radius);
+    Vector *displacements = array_data(model->displacements);
+
+    *displacement = vector_sub(
+        *(displacements + pair.a),
+        *(displacements + pair.b)
+    );
+
+    double a = *(radius + pair.a);
+    double b = *(radius + pair.b);
+    double size = a < b ? a : b;
+
+    return vector_dot(*displacement, *displacement) > size * size;
+}
+
+void model_narrow_phase(
+    Model *model,
+    Array *pairs,
+    Contacts *contacts,
+    NarrowPhase narrow_phase,
+    ModelStatistics *statistics
+) {
+    Vector *position = array_data(model->asteroids->position);
+    double *radius = array_data(model->asteroids->radius);
+    Pair *candidates = array_data(pairs);
+    int n = array_length(pairs);
+
+    // Still find the contacts if the previous contacts could not be indexed,
+    // but derive no events from them this increment.
+    bool events = contacts_begin(contacts);
+    array_resize(model->narrow, 0);
+
+    uint64_t rejects = 0;
+    uint64_t ccd_tests = 0;
+    uint64_t ccd_hits = 0;
+
+    for (int i = 0; i < n; i++) {
+
+        int a = candidates[i].a;
+        int b = candidates[i].b;
+
+        // Reject the pair if the bounding circles do not overlap, comparing
+        // squared distances to avoid a square root. For fast pairs, use the
+        // closest the circles came during the increment.
+        Vector d = vector_sub(*(position + a), *(position + b));
+        double r = *(radius + a) + *(radius + b);
+
+        Vector v;
+        if (model_pair_fast(model, candidates[i], &v)) {
+            double t = vector_dot(d, v) / vector_dot(v, v);
+            t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+            d = vector_sub(d, vector_scale(v, t));
+        }
+
+        if (vector_dot(d, d) > r * r) {
+            rejects++;
             continue;
+        }
+
+        pair_array_push_back(model->narrow, candidates[i]);
+    }
+
+    // Test the remaining pairs together.
+    int m = array_length(model->narrow);
+    if (m > 0 && array_resize(model->results, m)) {
+        Pair *narrow = array_data(model->narrow);
+        Collision *results = array_data(model->results);
 
-        Asteroid *A = *(Asteroid**)array_get(model->asteroids, i);
+        if (narrow_phase == NARROW_PHASE_GJK)
+            model_gjk_batch(model, narrow, m, results);
+        else
+            model_sat_batch(model, narrow, m, results, statistics);
+
+        // Sweep the fast pairs that were not overlapping at the end of the
+        // increment, in case they passed through each other.
+        Hull *hulls = array_data(model->hulls);
+        Vector *displacements = array_data(model->displacements);
 
-        for (int j = 0; j < n; j++) {
+        for (int i = 0; i < m; i++) {
 
-            // Skip checking if the same polygon is colliding with itself.
-            if (i == j)
+            Vector v;
+            if (results[i].colliding || !model_pair_fast(model, narrow[i], &v))
                 continue;
 
-            Asteroid *B = *(Asteroid**)array_get(model->asteroids, j);
+            ccd_tests++;
 
-            bool collision = false;
-            Vector mtv;
-            polygon_colliding(A->verticies, B->verticies, &collision, &mtv);
+            double toi;
+            bool touched = sat_time_of_impact(
+                hulls + narrow[i].a,
+                *(displacements + narrow[i].a),
+                hulls + narrow[i].b,
+                *(displacements + narrow[i].b),
+                &toi
+            );
 
-            if (collision) {
-                *(bool*)array_get(model->colliding, i) = true;
-                *(bool*)array_get(model->colliding, j) = true;
-            }
+            if (!touched)
+                continue;
+
+            ccd_hits++;
+            results[i].colliding = true;
+            results[i].toi = toi;
+            results[i].mtv = vector_scale(v, toi - 1.0);
+        }
+
+        for (int i = 0; i < m; i++) {
+            if (results[i].colliding)
+                contacts_add(
+                    contacts,
+                    narrow[i],
+                    asteroid_store_handle(model->asteroids, narrow[i].a),
+                    asteroid_store_handle(model->asteroids, narrow[i].b),
+                    results + i
+                );
+        }
+    }
+
+    if (events)
+        contacts_end(contacts);
+
+    if (statistics) {
+        statistics->candidates += n;
+        statistics->circle_rejects += rejects;
+        statistics->ccd_tests += ccd_tests;
+        statistics->ccd_hits += ccd_hits;
+    }
+}
+
+void model_cross_check(Model *model)
+{
+    // Find the colliding pairs by testing every pair.
+    model_broad_phase(model, BROAD_PHASE_BRUTE_FORCE, model->check_pairs);
+    model_narrow_phase(
+        model,
+        model->check_pairs,
+        model->check_contacts,
+        NARROW_PHASE_SAT,
+        NULL
+    );
+
+    // Sort both sets of contacts by pair and walk them together, reporting
+    // any pair that is only in one of them.
+    Array *check = contacts_current(model->check_contacts);
+    Array *current = contacts_current(model->contacts);
+    Contact *expected = array_data(check);
+    Contact *found = array_data(current);
+    int n_expected = array_length(check);
+    int n_found = array_length(current);
+
+    qsort(expected, n_expected, sizeof(Contact), pair_compare);
+    qsort(found, n_found, sizeof(Contact), pair_compare);
+
+    int i = 0;
+    int j = 0;
+    while (i < n_expected || j < n_found) {
+
+        int order;
+        if (i == n_expected)
+            order = 1;
+        else if (j == n_found)
+            order = -1;
+        else
+            order = pair_compare(expected + i, found + j);
+
+        if (order < 0) {
+            printf(
+                "Broad phase cross check: missed collision (%i, %i).\n",
+                expected[i].pair.a, expected[i].pair.b
+            );
+            i++;
+        }
+        else if (order > 0) {
+            printf(
+                "Broad phase cross check: unexpected collision (%i, %i).\n",
+                found[j].pair.a, found[j].pair.b
+            );
+            j++;
+        }
+        else {
+            i++;
+            j++;
+        }
+    }
+}
+
+/**
+ * Publish the state at the end of a step for the view to draw.
+ */
+void model_publish(Model *model, double seconds)
+{
+    if (!model->snapshots)
+        return;
+
+    Snapshot *snapshot = snapshot_buffer_write(model->snapshots);
+    Array *contacts = contacts_current(model->contacts);
+
+    if (!snapshot_capture(snapshot, model->asteroids, contacts))
+        return;
+
+    snapshot->time = time_global();
+    snapshot->step = seconds;
+    snapshot_buffer_publish(model->snapshots);
+}
+
+void model_step(Model *model, double seconds)
+{
+    int n = asteroid_store_length(model->asteroids);
+
+    // Keep the state before the step to interpolate the drawing from.
+    asteroid_store_save(model->asteroids);
+
+    if (!model->paused)
+        asteroid_store_advance(model->asteroids, seconds);
+
+    model->statistics.steps++;
+
+    Vector *position = array_data(model->asteroids->position);
+    Vector *velocity = array_data(model->asteroids->velocity);
+
+    bool scratch = model_scratch_create(model);
+
+    // Record how far each asteroid moved, for continuous collision detection,
+    // which is its velocity before bouncing over the step.
+    if (scratch && array_resize(model->displacements, n)) {
+        Vector *displacements = array_data(model->displacements);
+        for (int i = 0; i < n; i++) {
+            *(displacements + i) = model->paused
+                ? (Vector){0.0, 0.0}
+                : vector_scale(*(velocity + i), seconds);
         }
     }
+    else if (scratch)
+        array_resize(model->displacements, 0);
+
+    for (int i = 0; i < n; i++) {
+
+        if ((position + i)->x < -5)
+            (velocity + i)->x *= -1.0;
+
+        if ((position + i)->x > 5)
+            (velocity + i)->x *= -1.0;
+
+        if ((position + i)->y < -5)
+            (velocity + i)->y *= -1.0;
+
+        if ((position + i)->y > 5)
+            (velocity + i)->y *= -1.0;
+    }
+
+    // Skip collision detection if there is no memory for it this step, but
+    // still bounce the asteroids off the walls above.
+    if (!scratch) {
+        model_publish(model, seconds);
+        return;
+    }
+
+    // Determine collisions.
+    model_update_bounds(model);
+    model_broad_phase(model, model->broad_phase, model->pairs);
+    model_narrow_phase(
+        model,
+        model->pairs,
+        model->contacts,
+        model->narrow_phase,
+        &model->statistics
+    );
+
+    // Forget the simplices of pairs that are no longer candidates.
+    if (model->cache)
+        pair_cache_evict(model->cache);
+
+    if (model->cross_check)
+        model_cross_check(model);
+
+    model_publish(model, seconds);
+}
+
+/**
+ * Perform every command queued for the model. The model must be locked.
+ */
+void model_handle_commands(Model *model)
+{
+    if (!model->commands)
+        return;
+
+    Command command;
+    Time now = time_global();
+    while (ring_pop(model->commands, &command)) {
+        switch (command.type)
+        {
+            case COMMAND_MODEL_PAUSE_TOGGLE:
+                model->paused = !model->paused;
+                break;
+            default: break;
+        }
+
+        Time latency = now > command.time ? now - command.time : 0;
+        if (latency > model->statistics.command_latency_max)
+            model->statistics.command_latency_max = latency;
+
+        model->statistics.commands++;
+    }
+}
+
+void model_increment(void *data)
+{
+    Model *model = data;
+
+    // Lock access to the model data and advance the model.
+    SDL_LockMutex(model->mutex);
+
+    // Perform the controller's commands before simulating.
+    model_handle_commands(model);
+
+    // Simulate as many whole steps as real time has passed, carrying the
+    // remainder over to the next wake up, so that the simulation runs at the
+    // tick rate however often the thread wakes.
+    double step = 1.0 / model->tick_rate;
+    model->accumulator += time_to_seconds(time_since_last(&model->time_last));
+
+    int steps = 0;
+    while (model->accumulator >= step && steps < MODEL_MAX_CATCH_UP) {
+        model_step(model, step);
+        model->accumulator -= step;
+        steps++;
+    }
+
+    // If the model has fallen further behind than it may catch up in one wake
+    // up, drop the time it is behind by rather than spending ever longer
+    // catching up.
+    if (model->accumulator >= step) {
+        uint64_t dropped = (uint64_t)(model->accumulator / step);
+        model->statistics.dropped_steps += dropped;
+        model->accumulator = fmod(model->accumulator, step);
+    }
 
     SDL_UnlockMutex(model->mutex);
 }
@@ -142,24 +884,81 @@ void model_pause_toggle(Model *model)
     SDL_UnlockMutex(model->mutex);
 }
 
-void model_draw_polygon(
-    View *view,
-    Array *polygon
-) {
-    Vector *a = NULL;
-    Vector *b = NULL;
+bool model_command(Model *model, Command command)
+{
+    if (!model || !model->commands)
+        return false;
 
-    if (!array_at_pointer(polygon, 0, (void*)&a))
+    if (ring_push(model->commands, &command))
+        return true;
+
+    SDL_AtomicAdd(&model->dropped_commands, 1);
+    return false;
+}
+
+void model_set_broad_phase(Model *model, BroadPhase broad_phase)
+{
+    SDL_LockMutex(model->mutex);
+    model->broad_phase = broad_phase;
+    SDL_UnlockMutex(model->mutex);
+}
+
+void model_set_narrow_phase(Model *model, NarrowPhase narrow_phase)
+{
+    SDL_LockMutex(model->mutex);
+    model->narrow_phase = narrow_phase;
+    SDL_UnlockMutex(model->mutex);
+}
+
+void model_set_tick_rate(Model *model, int tick_rate)
+{
+    if (tick_rate <= 0)
         return;
 
-    for (int i = 0; i < array_length(polygon); i++) {
+    SDL_LockMutex(model->mutex);
+    model->tick_rate = tick_rate;
+    SDL_UnlockMutex(model->mutex);
+
+    if (model->thread) {
+        uint32_t interval = model_wake_interval(tick_rate);
+        interval_thread_set_interval(model->thread, interval);
+    }
+}
+
+void model_set_cross_check(Model *model, bool enabled)
+{
+    SDL_LockMutex(model->mutex);
+    model->cross_check = enabled;
+    SDL_UnlockMutex(model->mutex);
+}
 
-        // Get the second coordinate.
-        if (!array_at_pointer(polygon, (i + 1) % array_length(polygon), (void*)&b))
-            return;
+ModelStatistics model_statistics(Model *model)
+{
+    SDL_LockMutex(model->mutex);
+    AsteroidStore *asteroids = model->asteroids;
+    ModelStatistics statistics = model->statistics;
+    statistics.asteroids = asteroid_store_length(asteroids);
+    statistics.asteroid_high_water = asteroid_store_high_water(asteroids);
+    statistics.asteroid_capacity = asteroid_store_capacity(asteroids);
+    statistics.scratch_high_water = arena_high_water(model->arena);
+    statistics.scratch_capacity = arena_capacity(model->arena);
+    statistics.dropped_commands = SDL_AtomicGet(&model->dropped_commands);
+    SDL_UnlockMutex(model->mutex);
+    return statistics;
+}
 
-        Vector a_pixel = view_world_to_port(view->port, *a);
-        Vector b_pixel = view_world_to_port(view->port, *b);
+void model_draw_polygon(
+    View *view,
+    Vector *verticies,
+    int n
+) {
+    for (int i = 0; i < n; i++) {
+
+        Vector a = *(verticies + i);
+        Vector b = *(verticies + (i + 1) % n);
+
+        Vector a_pixel = view_world_to_port(view->port, a);
+        Vector b_pixel = view_world_to_port(view->port, b);
 
         SDL_RenderDrawLine(
             view->renderer,
@@ -168,61 +967,93 @@ void model_draw_polygon(
             b_pixel.x, 
             b_pixel.y
         );
-
-        a = b;
     }
 }
 
+/**
+ * Draw an asteroid of a snapshot interpolated between the start and end of
+ * the snapshot's step.
+ */
+void model_draw_asteroid(
+    View *view,
+    Model *model,
+    Snapshot *snapshot,
+    int index,
+    double alpha
+) {
+    SnapshotAsteroid *asteroid = snapshot_asteroid(snapshot, index);
+    ShapeTemplate *template = shape_library_get(model->shapes, asteroid->shape);
+    if (!array_resize(model->draw_verticies, template->verticies.count))
+        return;
+
+    Vector *verticies = array_data(model->draw_verticies);
+    int n = snapshot_interpolate(
+        snapshot,
+        model->shapes,
+        index,
+        alpha,
+        verticies
+    );
+    model_draw_polygon(view, verticies, n);
+}
+
 void model_draw(View *view, void *data)
 {
     Model *model = data;
-    SDL_LockMutex(model->mutex);
 
-    // Dereference required data once.
-    Asteroid **asteroids = array_data(model->asteroids);
-    int n = array_length(model->asteroids);
+    // Draw the latest published step rather than the model itself, so that
+    // drawing never waits for a step and a step never waits for drawing.
+    Snapshot *snapshot = snapshot_buffer_read(model->snapshots);
+    SnapshotAsteroid *asteroids = array_data(snapshot->asteroids);
+    int n = array_length(snapshot->asteroids);
 
     // Set to white lines.
     SDL_SetRenderDrawColor(view->renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
 
-    // For each polygon.
-    for (int i = 0; i < n; ++i) {
-
-        Asteroid *asteroid = *(asteroids + i);
-        Array *polygon = asteroid->verticies;
+    // Place each asteroid between the start and end of the step by how far
+    // real time is through the next step, so motion is smooth whatever the
+    // tick rate.
+    double alpha = 1.0;
+    if (snapshot->step > 0.0) {
+        double since = time_to_seconds(time_global() - snapshot->time);
+        alpha = since / snapshot->step;
+    }
+    alpha = alpha < 0.0 ? 0.0 : (alpha > 1.0 ? 1.0 : alpha);
 
-        bool colliding;
-        array_at_copy(model->colliding, i, (void*)&colliding);
+    // For each polygon.
+    for (int i = 0; i < n; ++i)
+        model_draw_asteroid(view, model, snapshot, i, alpha);
 
-        if (colliding)
-            SDL_SetRenderDrawColor(view->renderer, 255, 0, 0, 255);
-        else
-            SDL_SetRenderDrawColor(view->renderer, 255, 255, 255, 255);
+    // Draw over the colliding asteroids in red.
+    SDL_SetRenderDrawColor(view->renderer, 255, 0, 0, 255);
 
-        // Draw it.
-        model_draw_polygon(view, polygon);
+    for (int i = 0; i < n; i++) {
+        if ((asteroids + i)->colliding)
+            model_draw_asteroid(view, model, snapshot, i, alpha);
     }
-
-    SDL_UnlockMutex(model->mutex);
 }
 
 void model_destroy(Model *model)
 {
     interval_thread_destroy(model->thread);
 
-    Asteroid **asteroids = array_data(model->asteroids);
-    int n = array_length(model->asteroids);
-
-    // Destroy the polygons.
-    for (int i = 0; i < n; i++) {
-        asteroid_destroy(*(asteroids + i));
-    }
+    // Deallocate the asteroids and arrays.
+    asteroid_store_destroy(model->asteroids);
+    shape_library_destroy(model->shapes);
+    arena_destroy(model->arena);
+    contacts_destroy(model->check_contacts);
 
-    // Deallocate the arrays.
-    array_destroy(model->asteroids);
-    array_destroy(model->colliding);
+    grid_destroy(model->grid);
+    sweep_destroy(model->sweep);
+    aabb_tree_destroy(model->tree);
+    array_destroy(model->proxies);
+    snapshot_buffer_destroy(model->snapshots);
+    array_destroy(model->draw_verticies);
+    pair_cache_destroy(model->cache);
+    contacts_destroy(model->contacts);
 
     SDL_DestroyMutex(model->mutex);
+    ring_destroy(model->commands);
 
     free(model);
 }
@@ -2,30 +2,239 @@
 #define MODEL_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
+#include "util/definitions.h"
+#include "util/time.h"
 #include "view/view.h"
+#include "model/broadphase.h"
+
+// The number of asteroids created with the model, which the model reserves
+// memory for up front.
+#define MODEL_ASTEROIDS 10
+
+// The broad phase used to find candidate collision pairs.
+#define MODEL_BROAD_PHASE BROAD_PHASE_GRID
+
+// The number of fixed steps the model simulates per second.
+#define MODEL_TICK_RATE 60
+
+// The most steps the model simulates in one wake up of its thread to catch up
+// with real time. Time it is further behind by is dropped.
+#define MODEL_MAX_CATCH_UP 5
+
+// The number of bytes initially reserved for the scratch data of each tick.
+// The scratch memory grows to fit if this is exceeded.
+#define MODEL_ARENA_SIZE (64 * 1024)
+
+// The narrow phase used to test candidate collision pairs.
+#define MODEL_NARROW_PHASE NARROW_PHASE_SAT
+
+// The most commands that can be queued for the model at once.
+#define MODEL_COMMAND_CAPACITY 64
+
+// Whether to cross check the broad phase against brute force every tick.
+#define MODEL_CROSS_CHECK false
 
 typedef struct Model Model;
 
+/**
+ * Algorithms for testing whether a candidate pair of asteroids collide.
+ */
+typedef enum {
+    // The seperating axis theorem, testing batches of pairs at once.
+    NARROW_PHASE_SAT,
+    // Gilbert-Johnson-Keerthi with the expanding polytope algorithm, starting
+    // each pair from its simplex of the previous increment.
+    NARROW_PHASE_GJK
+} NarrowPhase;
+
+/**
+ * Counters of the work done by the model's collision detection, accumulated
+ * since the model was created, and the model's memory use. Work done by cross
+ * checking is not counted.
+ */
+typedef struct {
+    // Candidate pairs passed from the broad phase to the narrow phase.
+    uint64_t candidates;
+    // Candidate pairs rejected because their bounding circles do not overlap,
+    // without running the seperating axis test.
+    uint64_t circle_rejects;
+    // Pairs tested with the seperating axis test whose cached axis from the
+    // last increment was again the seperating axis, or again the axis of
+    // least overlap, and pairs whose axis changed or was not cached.
+    uint64_t axis_hits;
+    uint64_t axis_misses;
+    // Pairs that moved further than their size relative to each other in an
+    // increment and were not overlapping at its end, so were swept to find
+    // whether they touched during it, and the pairs that did.
+    uint64_t ccd_tests;
+    uint64_t ccd_hits;
+    // Fixed steps simulated, and steps dropped because the model fell too
+    // far behind real time to catch up.
+    uint64_t steps;
+    uint64_t dropped_steps;
+    // Commands performed, and the longest a command waited in the queue from
+    // being issued to being performed, in nanoseconds.
+    uint64_t commands;
+    Time command_latency_max;
+    // Commands dropped because the model's queue was full.
+    uint64_t dropped_commands;
+    // Asteroids spawned and despawned, including those created with the model.
+    uint64_t spawns;
+    uint64_t despawns;
+    // The number of asteroids, the most there have been at once, and the
+    // number the model has memory for before it must grow.
+    int asteroids;
+    int asteroid_high_water;
+    int asteroid_capacity;
+    // The most bytes of scratch memory used in one increment, and the number
+    // of bytes of scratch memory allocated from the heap.
+    size_t scratch_high_water;
+    size_t scratch_capacity;
+} ModelStatistics;
+
 /**
  * Create a new model instance.
  */
 Model *model_create();
 
 /**
- * Advance the model. Called continuously by spin_thread(). 
+ * Create a new model instance without a thread to advance it, for running the
+ * model without a view. The caller advances the model with model_step().
+ * 
+ * @returns Pointer to the model, or NULL on failure.
+ */
+Model *model_create_headless();
+
+/**
+ * Advance the model to the current time in fixed steps of its tick rate,
+ * simulating at most MODEL_MAX_CATCH_UP steps. Called continuously by the
+ * model's thread.
  * 
  * Thread safe.
  * 
- * @param model The model instance to advance by one step.
+ * @param model The model instance to advance.
  */
 void model_increment(void *model);
 
+/**
+ * Advance the model by exactly one step and detect its collisions, regardless
+ * of real time. The caller must hold the model exclusively.
+ * 
+ * @param model The model instance to advance.
+ * @param seconds The length of the step in seconds.
+ */
+void model_step(Model *model, double seconds);
+
+/**
+ * Spawn an asteroid with a random shape, position and velocity. Spawning up
+ * to MODEL_ASTEROIDS asteroids at once does not touch the heap. The caller
+ * must hold the model exclusively.
+ * 
+ * @param model The model instance.
+ * 
+ * @returns The index of the asteroid, or -1 on failure to allocate.
+ */
+int model_spawn(Model *model);
+
+/**
+ * Despawn an asteroid. The last asteroid is renumbered to its index, but keeps
+ * its handle. The caller must hold the model exclusively.
+ * 
+ * @param model The model instance.
+ * @param index The index of the asteroid.
+ * 
+ * @returns True on success, false if the index is out of range.
+ */
+bool model_despawn(Model *model, int index);
+
+/**
+ * Despawn an asteroid at random, if there are any, and spawn a new one in its
+ * place. The caller must hold the model exclusively.
+ * 
+ * @param model The model instance.
+ * 
+ * @returns True on success, false if the new asteroid could not be spawned.
+ */
+bool model_respawn(Model *model);
+
 void model_pause_toggle(Model *model);
 
+/**
+ * Queue a command for the model to perform at the start of its next tick.
+ * 
+ * Never blocks. Must only be called from one thread.
+ * 
+ * @param model The model instance.
+ * @param command The command to queue.
+ * 
+ * @returns True on success, false if the model's queue is full, in which case
+ * the command is dropped and counted in ModelStatistics.dropped_commands.
+ */
+bool model_command(Model *model, Command command);
+
+/**
+ * Select the broad phase used to find candidate collision pairs.
+ * 
+ * Thread safe.
+ * 
+ * @param model The model instance.
+ * @param broad_phase The broad phase to use from the next increment.
+ */
+void model_set_broad_phase(Model *model, BroadPhase broad_phase);
+
+/**
+ * Select the narrow phase used to test candidate collision pairs.
+ * 
+ * Thread safe.
+ * 
+ * @param model The model instance.
+ * @param narrow_phase The narrow phase to use from the next increment.
+ */
+void model_set_narrow_phase(Model *model, NarrowPhase narrow_phase);
+
+/**
+ * Set the number of fixed steps the model simulates per second. The model's
+ * thread wakes up once per step, and drawing interpolates between steps, so
+ * lower rates save time without making motion jerky.
+ * 
+ * Thread safe.
+ * 
+ * @param model The model instance.
+ * @param tick_rate The number of steps per second. Ignored if not positive.
+ */
+void model_set_tick_rate(Model *model, int tick_rate);
+
+/**
+ * Enable or disable cross checking the broad phase against brute force. When
+ * enabled, every increment also tests every pair of asteroids and reports any
+ * colliding pair that the selected broad phase missed or invented.
+ * 
+ * Thread safe.
+ * 
+ * @param model The model instance.
+ * @param enabled Whether to cross check.
+ */
+void model_set_cross_check(Model *model, bool enabled);
+
+/**
+ * Get the model's collision detection counters.
+ * 
+ * Thread safe.
+ * 
+ * @param model The model instance.
+ * @returns A copy of the model's counters.
+ */
+ModelStatistics model_statistics(Model *model);
+
 /**
  * Draw the model object to a renderer.
  * 
+ * Draws the state published at the end of the model's latest step, without
+ * locking the model. Must only be called from one thread.
+ * 
  * @param renderer Pointer to the renderer to draw the model with.
  * @param model Pointer to the model instance to draw.
  */
@@ -2,9 +2,9 @@
 
 #include <stdlib.h>
 
-Object *object_create()
+Object *object_create(Pool *pool)
 {
-    Object *object = malloc(sizeof(Object));
+    Object *object = pool ? pool_allocate(pool) : malloc(sizeof(Object));
     if (!object)
         return NULL;
 
@@ -25,17 +25,26 @@ Object *object_create()
 
 void object_advance(Object *object, double seconds)
 {
-    object->velocity = vector_add(object->velocity, object->acceleration);
-    object->position = vector_add(object->position, object->velocity);
-
-    object->omega += object->alpha;
-    object->angle += object->omega;
+    object->velocity = vector_add(
+        object->velocity,
+        vector_scale(object->acceleration, seconds)
+    );
+    object->position = vector_add(
+        object->position,
+        vector_scale(object->velocity, seconds)
+    );
+
+    object->omega += object->alpha * seconds;
+    object->angle += object->omega * seconds;
 }
 
-void object_destroy(Object *object)
+void object_destroy(Object *object, Pool *pool)
 {
     if (!object)
         return;
 
-    free(object);
+    if (pool)
+        pool_free(pool, object);
+    else
+        free(object);
 }
\ No newline at end of file
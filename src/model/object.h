@@ -1,6 +1,7 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+#include "util/pool.h"
 #include "util/vector.h"
 
 typedef struct {
@@ -16,9 +17,12 @@ typedef struct {
 /**
  * @brief Create a defaultly initalised object.
  * 
- * @returns A pointer to the object.
+ * @param pool The pool of Object sized blocks to allocate the object from, or
+ * NULL to allocate it on the heap.
+ * 
+ * @returns A pointer to the object, or NULL on failure.
  */
-Object *object_create();
+Object *object_create(Pool *pool);
 
 /**
  * @brief Update the attributes of an object after a given number of 
@@ -33,7 +37,9 @@ void object_advance(Object *object, double seconds);
  * after this call is undefined.
  * 
  * @param object The object to destroy.
+ * @param pool The pool the object was allocated from, or NULL if it was
+ * allocated on the heap.
  */
-void object_destroy(Object *object);
+void object_destroy(Object *object, Pool *pool);
 
 #endif // OBJECT_H
@@ -0,0 +1,87 @@
+#include "model/pair_cache.h"
+
+#include "util/array.h"
+#include "util/hashmap.h"
+
+struct PairCache {
+    // Entries keyed by the handles of the pair's bodies in order, since the
+    // simplex and axis of an entry depend on which body is first.
+    HashMap *entries;
+    // Keys of the entries to evict, reused between ticks.
+    Array *stale;
+    // The current tick. Starts at 1 so that no entry is fresh before use.
+    uint32_t tick;
+};
+
+PairCache *pair_cache_create()
+{
+    PairCache *cache = malloc(sizeof(PairCache));
+    if (!cache)
+        return NULL;
+
+    cache->entries = hashmap_create(sizeof(PairCacheEntry));
+    cache->stale = array_create(sizeof(uint64_t));
+    cache->tick = 1;
+
+    if (!cache->entries || !cache->stale) {
+        hashmap_destroy(cache->entries);
+        if (cache->stale)
+            array_destroy(cache->stale);
+        free(cache);
+        return NULL;
+    }
+
+    return cache;
+}
+
+PairCacheEntry *pair_cache_get(PairCache *cache, Handle a, Handle b)
+{
+    uint64_t key = ((uint64_t)a << 32) | b;
+
+    PairCacheEntry *entry = hashmap_find(cache->entries, key);
+    if (!entry) {
+        PairCacheEntry empty = {0, {{0}, {0}, 0}, -1};
+        entry = hashmap_insert(cache->entries, key, &empty);
+        if (!entry)
+            return NULL;
+    }
+
+    entry->tick = cache->tick;
+    return entry;
+}
+
+void pair_cache_evict(PairCache *cache)
+{
+    // The map cannot be modified while iterating it, so collect the keys of
+    // the stale entries first.
+    array_resize(cache->stale, 0);
+
+    int iterator = 0;
+    uint64_t key;
+    void *value;
+    while (hashmap_next(cache->entries, &iterator, &key, &value)) {
+        if (((PairCacheEntry*)value)->tick != cache->tick)
+            array_push_back(cache->stale, &key);
+    }
+
+    uint64_t *stale = array_data(cache->stale);
+    for (int i = 0; i < array_length(cache->stale); i++)
+        hashmap_erase(cache->entries, stale[i]);
+
+    cache->tick++;
+}
+
+void pair_cache_clear(PairCache *cache)
+{
+    hashmap_clear(cache->entries);
+}
+
+void pair_cache_destroy(PairCache *cache)
+{
+    if (!cache)
+        return;
+
+    hashmap_destroy(cache->entries);
+    array_destroy(cache->stale);
+    free(cache);
+}
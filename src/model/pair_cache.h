@@ -0,0 +1,74 @@
+#ifndef PAIR_CACHE_H
+#define PAIR_CACHE_H
+
+#include <stdint.h>
+
+#include "util/handle.h"
+#include "model/broadphase.h"
+#include "model/gjk.h"
+
+/**
+ * Data remembered about a pair of bodies between ticks.
+ */
+typedef struct {
+    // The tick the entry was last used on.
+    uint32_t tick;
+    // The last GJK simplex of the pair.
+    Simplex simplex;
+    // The last seperating axis of the pair, or its axis of least overlap if
+    // it was colliding, as numbered by sat_colliding_batch(). -1 if unknown.
+    int axis;
+} PairCacheEntry;
+
+/**
+ * A cache of data about pairs of bodies that persists between ticks, keyed by
+ * the handles of the bodies so that entries survive bodies being renumbered.
+ * Entries that are not used during a tick are evicted at the end of it, so
+ * the cache only holds the pairs that are currently candidates.
+ */
+typedef struct PairCache PairCache;
+
+/**
+ * Create a new empty pair cache.
+ * 
+ * @returns A pointer to the cache, or NULL on failure.
+ */
+PairCache *pair_cache_create();
+
+/**
+ * Get the entry of a pair, creating an entry with an empty simplex and no
+ * axis if the pair has none, and mark it as used this tick.
+ * 
+ * @param cache The cache.
+ * @param a The handle of the first body of the pair.
+ * @param b The handle of the second body of the pair. If the bodies are
+ * renumbered such that their order in the pair swaps, the pair gets a new
+ * entry.
+ * 
+ * @returns Pointer to the entry, valid until the cache is next modified, or
+ * NULL on failure to allocate.
+ */
+PairCacheEntry *pair_cache_get(PairCache *cache, Handle a, Handle b);
+
+/**
+ * End the tick, evicting every entry that was not used during it.
+ * 
+ * @param cache The cache.
+ */
+void pair_cache_evict(PairCache *cache);
+
+/**
+ * Remove every entry from the cache.
+ * 
+ * @param cache The cache.
+ */
+void pair_cache_clear(PairCache *cache);
+
+/**
+ * Deallocate a pair cache. Using the cache after this call is undefined.
+ * 
+ * @param cache The cache to destroy.
+ */
+void pair_cache_destroy(PairCache *cache);
+
+#endif // PAIR_CACHE_H
@@ -1,5 +1,6 @@
 #include "model/polygon.h"
 
+#include <float.h>
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -8,18 +9,20 @@
 
 Array *polygon_create()
 {
-    return array_create(sizeof(Vector));
+    return array_create_inline(sizeof(Vector), POLYGON_INLINE_VERTICIES);
 }
 
 Array *polygon_create_random_regular(double radius)
+{
+    return polygon_create_regular(random_int(3, 5), radius);
+}
+
+Array *polygon_create_regular(int n, double radius)
 {
     Array *polygon = polygon_create();
     if (!polygon)
         return NULL;
 
-    // The number of verticies.
-    int n = random_int(3, 5);
-
     // The angle between each vertex.
     double d = 2 * M_PI / n;
 
@@ -35,22 +38,101 @@ Array *polygon_create_random_regular(double radius)
     return polygon;
 }
 
+AABB polygon_bounds(Array *polygon)
+{
+    Hull hull = {array_data(polygon), array_length(polygon), NULL, 0};
+    return polygon_bounds_hull(&hull);
+}
+
+AABB polygon_bounds_hull(Hull *hull)
+{
+    Vector *verticies = hull->verticies;
+    int n = hull->n;
+
+    AABB bounds = {{0.0, 0.0}, {0.0, 0.0}};
+    if (n == 0)
+        return bounds;
+
+    bounds.min = bounds.max = *verticies;
+    for (int i = 1; i < n; i++) {
+        Vector v = *(verticies + i);
+        if (v.x < bounds.min.x)
+            bounds.min.x = v.x;
+        else if (v.x > bounds.max.x)
+            bounds.max.x = v.x;
+        if (v.y < bounds.min.y)
+            bounds.min.y = v.y;
+        else if (v.y > bounds.max.y)
+            bounds.max.y = v.y;
+    }
+
+    return bounds;
+}
+
+double polygon_radius(Array *polygon)
+{
+    Vector *verticies = array_data(polygon);
+    int n = array_length(polygon);
+
+    // Compare squared distances and take one square root at the end.
+    double radius = 0.0;
+    for (int i = 0; i < n; i++) {
+        double distance = vector_dot(*(verticies + i), *(verticies + i));
+        if (distance > radius)
+            radius = distance;
+    }
+
+    return sqrt(radius);
+}
+
+Array *polygon_axes(Array *polygon)
+{
+    Array *axes = array_create_inline(sizeof(Vector), POLYGON_INLINE_VERTICIES);
+    if (!axes)
+        return NULL;
+
+    Vector *verticies = array_data(polygon);
+    int n = array_length(polygon);
+
+    for (int i = 0; i < n; i++) {
+
+        // The seperating axis is the unit vector perpendicular to the edge.
+        Vector edge = vector_sub(*(verticies + (i + 1) % n), *(verticies + i));
+        if (edge.x == 0.0 && edge.y == 0.0)
+            continue;
+
+        Vector axis = vector_unit(vector_perp(edge));
+
+        // Parallel edges project onto the same axis, so only keep one of
+        // them. Unit axes are parallel when their cross product is zero.
+        bool duplicate = false;
+        Vector *unique = array_data(axes);
+        for (int j = 0; j < array_length(axes) && !duplicate; j++) {
+            double cross = axis.x * unique[j].y - axis.y * unique[j].x;
+            duplicate = fabs(cross) < POLYGON_PARALLEL_EPSILON;
+        }
+
+        if (!duplicate && !array_push_back(axes, &axis)) {
+            array_destroy(axes);
+            return NULL;
+        }
+    }
+
+    return axes;
+}
+
 bool polygon_axes_shadow_overlap(
+    Vector *axes,
+    int K,
     Vector *A,
-    Vector *B,
     int N,
+    Vector *B,
     int M,
     double *minimum_overlap,
     Vector *minimum_axis
 ) {
-    // Get the edge coordinates of polygon A.
-    Vector a = *A;
-    for (int i = 0; i < N; i++) {
-        Vector b = *(A + i + 1);
-
-        // Calculate the seperating axis as the vector perpendicular to the
-        // edge of polygon A.
-        Vector axis = vector_unit(vector_perp(vector_sub(b, a)));
+    for (int k = 0; k < K; k++) {
+        Vector axis = *(axes + k);
 
         // The shadow of polygon A.
         double A_max = vector_dot(axis, *A);
@@ -74,63 +156,85 @@ bool polygon_axes_shadow_overlap(
                 B_min = projection;
         }
 
-        if (B_min > A_max || B_max < A_min) {
+        if (B_min > A_max || B_max < A_min)
             return false;
-        }
-        else {
-
-            // Calculate the overlap
-            double overlap = B_min < A_min ? A_min - B_min : A_max - B_min;
-            if (overlap < *minimum_overlap) {
-                *minimum_overlap = overlap;
-                *minimum_axis = axis;
-            }
-        }
 
-        a = b;
+        // Calculate how far A needs to move along the axis to leave B in
+        // either direction, and point the axis in the shorter direction.
+        double left = A_max - B_min;
+        double right = B_max - A_min;
+        double overlap = left < right ? left : right;
+        if (overlap < *minimum_overlap) {
+            *minimum_overlap = overlap;
+            *minimum_axis = A_min + A_max < B_min + B_max
+                ? vector_scale(axis, -1.0)
+                : axis;
+        }
     }
 
     return true;
 }
 
-bool polygon_colliding(
-    Array *polygon_A,
-    Array *polygon_B,
-    bool *colliding,
-    Vector *mtv
-) {
-    // This algorithm takes the line segments of polygon A, and projects
-    // the shadow of polygon B onto that line. If the shadow of B doesn't
-    // overlap with the line segment of A, then the polygons are not colliding.
-    // Otherwise we continue to loop through the line segments of polygon A.
+bool polygon_colliding_hull(Hull *A, Hull *B, bool *colliding, Vector *mtv)
+{
+    // This algorithm takes the seperating axes of polygon A and B, and
+    // projects the shadow of both polygons onto each axis. If the shadows
+    // don't overlap on any axis, then the polygons are not colliding.
     // If we cannot find a seperating axis, then the polygons are colliding.
 
-    // For performance, get the raw data buffers of each polygon.
-    Vector *A = array_data(polygon_A);
-    Vector *B = array_data(polygon_B);
-
-    // Get the length of the data buffers.
-    int N = array_length(polygon_A);
-    int M = array_length(polygon_B);
-
     // Require the polygons to have at least 3 coordinates.
-    if (N < 3 || M < 3)
+    if (A->n < 3 || B->n < 3)
         return false;
 
-    double overlap_A, overlap_B;
-    Vector axis_A, axis_B;
+    double overlap = DBL_MAX;
+    Vector axis = {0.0, 0.0};
 
     *colliding = (
-        polygon_axes_shadow_overlap(A, B, N, M, &overlap_A, &axis_A) &&
-        polygon_axes_shadow_overlap(B, A, M, N, &overlap_B, &axis_B)
+        polygon_axes_shadow_overlap(
+            A->axes, A->m, A->verticies, A->n, B->verticies, B->n,
+            &overlap, &axis
+        ) &&
+        polygon_axes_shadow_overlap(
+            B->axes, B->m, A->verticies, A->n, B->verticies, B->n,
+            &overlap, &axis
+        )
     );
 
-    if (*colliding) {
-        if (overlap_A < overlap_B)
-            *mtv = vector_scale(axis_A, overlap_A);
-        else
-            *mtv = vector_scale(axis_B, overlap_B);
-    }
+    if (*colliding)
+        *mtv = vector_scale(axis, overlap);
 
     return true;
 }
+
+bool polygon_colliding(
+    Array *polygon_A,
+    Array *polygon_B,
+    bool *colliding,
+    Vector *mtv
+) {
+    // Calculate the seperating axes of both polygons, since they are not
+    // cached.
+    Array *axes_A = polygon_axes(polygon_A);
+    Array *axes_B = polygon_axes(polygon_B);
+
+    bool success = false;
+
+    if (axes_A && axes_B) {
+        Hull A = {
+            array_data(polygon_A), array_length(polygon_A),
+            array_data(axes_A), array_length(axes_A)
+        };
+        Hull B = {
+            array_data(polygon_B), array_length(polygon_B),
+            array_data(axes_B), array_length(axes_B)
+        };
+        success = polygon_colliding_hull(&A, &B, colliding, mtv);
+    }
+
+    if (axes_A)
+        array_destroy(axes_A);
+    if (axes_B)
+        array_destroy(axes_B);
+
+    return success;
+}
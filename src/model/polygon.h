@@ -5,14 +5,51 @@
 
 #include "util/array.h"
 #include "util/vector.h"
+#include "model/aabb.h"
+
+// Axes whose cross product is smaller than this are considered parallel.
+#define POLYGON_PARALLEL_EPSILON 1e-9
+
+// The number of verticies stored inline with a polygon's Array before they
+// spill onto the heap.
+#define POLYGON_INLINE_VERTICIES 8
+
+/**
+ * A view of a polygon prepared for collision detection. Holds the polygon's
+ * world space verticies and the unique unit normals of its edges, which are
+ * the seperating axes tested by the seperating axis theorem. Neither buffer
+ * is owned by the hull.
+ */
+typedef struct {
+    // The verticies of the polygon.
+    Vector *verticies;
+    // The number of verticies.
+    int n;
+    // The unique seperating axes of the polygon.
+    Vector *axes;
+    // The number of axes.
+    int m;
+} Hull;
 
 /**
  * A polygon is simply an array of Vector coordinates, such that the last
  * coordinate wraps around the the first coordinate. Ordered pairs of points in
- * the array define the line segments of the polygon.
+ * the array define the line segments of the polygon. Up to
+ * POLYGON_INLINE_VERTICIES verticies are stored inline with the array.
  */
 Array *polygon_create();
 
+/**
+ * @brief Create a regular polygon with its first vertex on the x axis.
+ * 
+ * @param n The number of verticies.
+ * @param radius The distance of each vertex from the origin.
+ * 
+ * @returns Pointer to the new polygon, being an Array of Vector, or NULL on
+ * failure.
+ */
+Array *polygon_create_regular(int n, double radius);
+
 /**
  * @brief Create a random regular polygon.
  * 
@@ -20,16 +57,77 @@ Array *polygon_create();
  */
 Array *polygon_create_random_regular(double radius);
 
+/**
+ * @brief Calculate the axis aligned bounding box of a polygon.
+ * 
+ * @param polygon The polygon, being an Array of Vector.
+ * 
+ * @returns The smallest box containing all verticies of the polygon.
+ */
+AABB polygon_bounds(Array *polygon);
+
+/**
+ * @brief Calculate the axis aligned bounding box of a hull.
+ * 
+ * @param hull The hull. Only its verticies are used.
+ * 
+ * @returns The smallest box containing all verticies of the hull.
+ */
+AABB polygon_bounds_hull(Hull *hull);
+
+/**
+ * @brief Calculate the bounding radius of a polygon about its local origin.
+ * 
+ * @param polygon The polygon, being an Array of Vector.
+ * 
+ * @returns The distance from the origin to the furthest vertex.
+ */
+double polygon_radius(Array *polygon);
+
+/**
+ * @brief Calculate the seperating axes of a polygon, being the unit normals of
+ * its edges. Parallel edges share an axis, which is only included once, so a
+ * square has 2 axes rather than 4.
+ * 
+ * The axes only depend on the polygon's shape and orientation, so they can be
+ * calculated once in local space and rotated with the polygon.
+ * 
+ * @param polygon The polygon, being an Array of Vector.
+ * 
+ * @returns Pointer to a new Array of Vector of the axes, or NULL on failure.
+ */
+Array *polygon_axes(Array *polygon);
+
+/**
+ * @brief Determine whether two hulls are colliding using the seperating axis
+ * theorem. Calculate the minimum translation vector out of the polygon if
+ * they are.
+ * 
+ * @param A The first hull.
+ * @param B The second hull.
+ * @param colliding The bool to set to true if A and B are colliding, otherwise
+ * set to false.
+ * @param mtv Pointer to store the minimum translation vector, being the
+ * smallest translation of A that seperates it from B.
+ * 
+ * @returns True if the algorithm succeeded, otherwise false.
+ */
+bool polygon_colliding_hull(Hull *A, Hull *B, bool *colliding, Vector *mtv);
+
 /**
  * @brief Determine whether two polygons are colliding using the seperating axis
  * theorem. Calculate the minimum translation vector out of the polygon if
  * they are.
  * 
+ * The seperating axes are calculated on every call. Prefer
+ * polygon_colliding_hull() with cached axes where possible.
+ * 
  * @param a The first polygon.
  * @param b The second polygon.
  * @param colliding The bool to set to true if a and b are colliding, otherwise
  * set to false.
- * @param mtv Pointer to store the minimum translation vector.
+ * @param mtv Pointer to store the minimum translation vector, being the
+ * smallest translation of A that seperates it from B.
  * 
  * @returns True if the algorithm succeeded, otherwise false.
  */
@@ -0,0 +1,434 @@
+#include "model/sat.h"
+
+#include <float.h>
+
+#include "SDL2/SDL.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SAT_X86
+#include <immintrin.h>
+#endif
+
+// Signature of the kernels, each of which tests a single pair and writes the
+// index of the seperating axis, or of the axis of least overlap, to axis.
+typedef void(SatKernelFunction)(Hull *A, Hull *B, int *axis, Collision *result);
+
+/**
+ * Get an axis of a pair by its index, counting the axes of A then B.
+ */
+static inline Vector sat_axis(Hull *A, Hull *B, int index)
+{
+    return index < A->m ? A->axes[index] : B->axes[index - A->m];
+}
+
+/**
+ * Project a hull onto an axis.
+ */
+static inline void sat_project(Hull *H, Vector axis, double *min, double *max)
+{
+    *min = DBL_MAX;
+    *max = -DBL_MAX;
+    for (int j = 0; j < H->n; j++) {
+        double p = vector_dot(axis, H->verticies[j]);
+        *min = p < *min ? p : *min;
+        *max = p > *max ? p : *max;
+    }
+}
+
+/**
+ * Project both hulls onto an axis.
+ * 
+ * @param direction Set to the difference of the shadow centres, scaled by two,
+ * which is negative if A must move against the axis to leave B.
+ * @returns The distance A needs to move along the axis to leave B, which is
+ * negative if the shadows are seperated.
+ */
+static double sat_axis_overlap(Hull *A, Hull *B, Vector axis, double *direction)
+{
+    double a_min, a_max, b_min, b_max;
+    sat_project(A, axis, &a_min, &a_max);
+    sat_project(B, axis, &b_min, &b_max);
+
+    *direction = (a_min + a_max) - (b_min + b_max);
+
+    double left = a_max - b_min;
+    double right = b_max - a_min;
+    return left < right ? left : right;
+}
+
+static void sat_scalar(Hull *A, Hull *B, int *axis, Collision *result)
+{
+    if (A->n < 3 || B->n < 3)
+        return;
+
+    int k = A->m + B->m;
+    int minimum = -1;
+    double minimum_overlap = DBL_MAX;
+    double minimum_direction = 0.0;
+
+    for (int i = 0; i < k; i++) {
+        double direction;
+        double overlap = sat_axis_overlap(A, B, sat_axis(A, B, i), &direction);
+
+        if (overlap < 0.0) {
+            *axis = i;
+            return;
+        }
+
+        if (overlap < minimum_overlap) {
+            minimum = i;
+            minimum_overlap = overlap;
+            minimum_direction = direction;
+        }
+    }
+
+    if (minimum < 0)
+        return;
+
+    // Point the axis in the direction A needs to move to leave B.
+    Vector v = sat_axis(A, B, minimum);
+    double sign = minimum_direction < 0.0 ? -1.0 : 1.0;
+    *axis = minimum;
+    result->colliding = true;
+    result->mtv = vector_scale(v, sign * minimum_overlap);
+}
+
+#ifdef SAT_X86
+
+/**
+ * Gather the axes of both hulls into seperate x and y buffers so that
+ * consecutive axes can be loaded into one vector register. The buffers are
+ * padded to a multiple of width by repeating the last axis, which does not
+ * change the result.
+ * 
+ * @returns The padded number of axes, or 0 if there are too many axes.
+ */
+static int sat_gather_axes(Hull *A, Hull *B, int width, double *x, double *y)
+{
+    int k = A->m + B->m;
+    int padded = (k + width - 1) / width * width;
+    if (k == 0 || padded > SAT_BATCH_AXES)
+        return 0;
+
+    for (int i = 0; i < A->m; i++) {
+        x[i] = A->axes[i].x;
+        y[i] = A->axes[i].y;
+    }
+    for (int i = 0; i < B->m; i++) {
+        x[A->m + i] = B->axes[i].x;
+        y[A->m + i] = B->axes[i].y;
+    }
+    for (int i = k; i < padded; i++) {
+        x[i] = x[k - 1];
+        y[i] = y[k - 1];
+    }
+
+    return padded;
+}
+
+/**
+ * Choose the axis of least overlap from the overlaps and shadow centres of
+ * every axis, and write the result and the index of the axis. 
+ */
+static void sat_resolve(
+    double *x,
+    double *y,
+    double *overlap,
+    double *direction,
+    int k,
+    int *axis,
+    Collision *result
+) {
+    int minimum = 0;
+    for (int i = 1; i < k; i++) {
+        if (overlap[i] < overlap[minimum])
+            minimum = i;
+    }
+
+    // Point the axis in the direction A needs to move to leave B.
+    double sign = direction[minimum] < 0.0 ? -1.0 : 1.0;
+    *axis = minimum;
+    result->colliding = true;
+    result->mtv = (Vector){
+        x[minimum] * sign * overlap[minimum],
+        y[minimum] * sign * overlap[minimum]
+    };
+}
+
+__attribute__((target("sse2")))
+static void sat_sse2(Hull *A, Hull *B, int *axis, Collision *result)
+{
+    double x[SAT_BATCH_AXES];
+    double y[SAT_BATCH_AXES];
+    double overlap[SAT_BATCH_AXES];
+    double direction[SAT_BATCH_AXES];
+
+    int k = sat_gather_axes(A, B, 2, x, y);
+    if (A->n < 3 || B->n < 3 || k == 0) {
+        sat_scalar(A, B, axis, result);
+        return;
+    }
+
+    for (int i = 0; i < k; i += 2) {
+        __m128d ax = _mm_loadu_pd(x + i);
+        __m128d ay = _mm_loadu_pd(y + i);
+
+        // Project every vertex of A onto both axes at once.
+        __m128d a_min = _mm_set1_pd(DBL_MAX);
+        __m128d a_max = _mm_set1_pd(-DBL_MAX);
+        for (int j = 0; j < A->n; j++) {
+            __m128d p = _mm_add_pd(
+                _mm_mul_pd(ax, _mm_set1_pd(A->verticies[j].x)),
+                _mm_mul_pd(ay, _mm_set1_pd(A->verticies[j].y))
+            );
+            a_min = _mm_min_pd(a_min, p);
+            a_max = _mm_max_pd(a_max, p);
+        }
+
+        // Then every vertex of B.
+        __m128d b_min = _mm_set1_pd(DBL_MAX);
+        __m128d b_max = _mm_set1_pd(-DBL_MAX);
+        for (int j = 0; j < B->n; j++) {
+            __m128d p = _mm_add_pd(
+                _mm_mul_pd(ax, _mm_set1_pd(B->verticies[j].x)),
+                _mm_mul_pd(ay, _mm_set1_pd(B->verticies[j].y))
+            );
+            b_min = _mm_min_pd(b_min, p);
+            b_max = _mm_max_pd(b_max, p);
+        }
+
+        // The distance A needs to move along each axis to leave B. The
+        // shadows are seperated on an axis if it is negative.
+        __m128d o = _mm_min_pd(
+            _mm_sub_pd(a_max, b_min),
+            _mm_sub_pd(b_max, a_min)
+        );
+        int separated = _mm_movemask_pd(_mm_cmplt_pd(o, _mm_setzero_pd()));
+        if (separated) {
+            *axis = i + __builtin_ctz(separated);
+            return;
+        }
+
+        _mm_storeu_pd(overlap + i, o);
+        _mm_storeu_pd(
+            direction + i,
+            _mm_sub_pd(_mm_add_pd(a_min, a_max), _mm_add_pd(b_min, b_max))
+        );
+    }
+
+    sat_resolve(x, y, overlap, direction, k, axis, result);
+}
+
+__attribute__((target("avx2")))
+static void sat_avx2(Hull *A, Hull *B, int *axis, Collision *result)
+{
+    double x[SAT_BATCH_AXES];
+    double y[SAT_BATCH_AXES];
+    double overlap[SAT_BATCH_AXES];
+    double direction[SAT_BATCH_AXES];
+
+    int k = sat_gather_axes(A, B, 4, x, y);
+    if (A->n < 3 || B->n < 3 || k == 0) {
+        sat_scalar(A, B, axis, result);
+        return;
+    }
+
+    for (int i = 0; i < k; i += 4) {
+        __m256d ax = _mm256_loadu_pd(x + i);
+        __m256d ay = _mm256_loadu_pd(y + i);
+
+        // Project every vertex of A onto four axes at once.
+        __m256d a_min = _mm256_set1_pd(DBL_MAX);
+        __m256d a_max = _mm256_set1_pd(-DBL_MAX);
+        for (int j = 0; j < A->n; j++) {
+            __m256d p = _mm256_add_pd(
+                _mm256_mul_pd(ax, _mm256_set1_pd(A->verticies[j].x)),
+                _mm256_mul_pd(ay, _mm256_set1_pd(A->verticies[j].y))
+            );
+            a_min = _mm256_min_pd(a_min, p);
+            a_max = _mm256_max_pd(a_max, p);
+        }
+
+        // Then every vertex of B.
+        __m256d b_min = _mm256_set1_pd(DBL_MAX);
+        __m256d b_max = _mm256_set1_pd(-DBL_MAX);
+        for (int j = 0; j < B->n; j++) {
+            __m256d p = _mm256_add_pd(
+                _mm256_mul_pd(ax, _mm256_set1_pd(B->verticies[j].x)),
+                _mm256_mul_pd(ay, _mm256_set1_pd(B->verticies[j].y))
+            );
+            b_min = _mm256_min_pd(b_min, p);
+            b_max = _mm256_max_pd(b_max, p);
+        }
+
+        // The distance A needs to move along each axis to leave B. The
+        // shadows are seperated on an axis if it is negative.
+        __m256d o = _mm256_min_pd(
+            _mm256_sub_pd(a_max, b_min),
+            _mm256_sub_pd(b_max, a_min)
+        );
+        int separated = _mm256_movemask_pd(
+            _mm256_cmp_pd(o, _mm256_setzero_pd(), _CMP_LT_OQ)
+        );
+        if (separated) {
+            *axis = i + __builtin_ctz(separated);
+            return;
+        }
+
+        _mm256_storeu_pd(overlap + i, o);
+        _mm256_storeu_pd(
+            direction + i,
+            _mm256_sub_pd(
+                _mm256_add_pd(a_min, a_max),
+                _mm256_add_pd(b_min, b_max)
+            )
+        );
+    }
+
+    sat_resolve(x, y, overlap, direction, k, axis, result);
+}
+
+#endif // SAT_X86
+
+bool sat_time_of_impact(Hull *A, Vector a, Hull *B, Vector b, double *toi)
+{
+    if (A->n < 3 || B->n < 3)
+        return false;
+
+    // Work in the frame of B, so only A moves.
+    Vector v = vector_sub(a, b);
+
+    double enter = 0.0;
+    double exit = 1.0;
+
+    int k = A->m + B->m;
+    for (int i = 0; i < k; i++) {
+        Vector axis = sat_axis(A, B, i);
+
+        double a_min, a_max, b_min, b_max;
+        sat_project(A, axis, &a_min, &a_max);
+        sat_project(B, axis, &b_min, &b_max);
+
+        // The shadow of A at the start of the increment, and how far it moves.
+        double speed = vector_dot(axis, v);
+        a_min -= speed;
+        a_max -= speed;
+
+        // Shadows that do not move along the axis overlap for the whole
+        // increment or not at all.
+        if (fabs(speed) < DBL_EPSILON) {
+            if (a_max < b_min || a_min > b_max)
+                return false;
+            continue;
+        }
+
+        // The fractions of the increment at which the shadows start and stop
+        // overlapping.
+        double t_min = (b_min - a_max) / speed;
+        double t_max = (b_max - a_min) / speed;
+        if (t_min > t_max) {
+            double t = t_min;
+            t_min = t_max;
+            t_max = t;
+        }
+
+        enter = t_min > enter ? t_min : enter;
+        exit = t_max < exit ? t_max : exit;
+        if (enter > exit)
+            return false;
+    }
+
+    *toi = enter;
+    return true;
+}
+
+// The selected kernel and its function. Selected on first use.
+static SatKernel s_sat_kernel = SAT_KERNEL_SCALAR;
+static SatKernelFunction *s_sat_function = NULL;
+
+static bool sat_supported(SatKernel kernel)
+{
+    switch (kernel)
+    {
+#ifdef SAT_X86
+        case SAT_KERNEL_AVX2: return SDL_HasAVX2();
+        case SAT_KERNEL_SSE2: return SDL_HasSSE2();
+#endif
+        case SAT_KERNEL_SCALAR: return true;
+        default: return false;
+    }
+}
+
+bool sat_select_kernel(SatKernel kernel)
+{
+    if (!sat_supported(kernel))
+        return false;
+
+    switch (kernel)
+    {
+#ifdef SAT_X86
+        case SAT_KERNEL_AVX2: s_sat_function = sat_avx2; break;
+        case SAT_KERNEL_SSE2: s_sat_function = sat_sse2; break;
+#endif
+        default: s_sat_function = sat_scalar; break;
+    }
+
+    s_sat_kernel = kernel;
+    return true;
+}
+
+static void sat_select_best()
+{
+    // Prefer the widest supported vector instructions.
+    if (!sat_select_kernel(SAT_KERNEL_AVX2) &&
+        !sat_select_kernel(SAT_KERNEL_SSE2)) {
+        sat_select_kernel(SAT_KERNEL_SCALAR);
+    }
+}
+
+SatKernel sat_kernel()
+{
+    if (!s_sat_function)
+        sat_select_best();
+
+    return s_sat_kernel;
+}
+
+void sat_colliding_batch(
+    Hull *hulls,
+    Pair *pairs,
+    int n,
+    int *axes,
+    Collision *results
+) {
+    if (!s_sat_function)
+        sat_select_best();
+
+    SatKernelFunction *kernel = s_sat_function;
+
+    for (int i = 0; i < n; i++) {
+
+        Hull *A = hulls + pairs[i].a;
+        Hull *B = hulls + pairs[i].b;
+        int axis = -1;
+
+        // Every kernel leaves the result as seperated unless it finds the
+        // pair colliding.
+        results[i] = (Collision){false, {0.0, 0.0}, 1.0};
+
+        // Test the hinted axis alone first, since a pair that was seperated
+        // last increment is most likely still seperated by the same axis.
+        if (axes && axes[i] >= 0 && axes[i] < A->m + B->m &&
+            A->n >= 3 && B->n >= 3) {
+            double direction;
+            Vector hint = sat_axis(A, B, axes[i]);
+            if (sat_axis_overlap(A, B, hint, &direction) < 0.0)
+                continue;
+        }
+
+        kernel(A, B, &axis, results + i);
+
+        if (axes)
+            axes[i] = axis;
+    }
+}
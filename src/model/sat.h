@@ -0,0 +1,109 @@
+#ifndef SAT_H
+#define SAT_H
+
+#include <stdbool.h>
+
+#include "util/vector.h"
+#include "model/polygon.h"
+#include "model/broadphase.h"
+
+// The most seperating axes of a pair that the vector kernels can test. Pairs
+// with more axes are tested by the scalar kernel.
+#define SAT_BATCH_AXES 256
+
+/**
+ * The result of testing a pair of hulls for collision.
+ */
+typedef struct {
+    // Whether the hulls are colliding.
+    bool colliding;
+    // The smallest translation of the first hull that seperates it from the
+    // second, if they are colliding. If they only collided part way through
+    // the increment, the translation of the first hull relative to the second
+    // back to where they first touched.
+    Vector mtv;
+    // The fraction of the increment at which the hulls first touched, or 1 if
+    // they were found overlapping at the end of the increment.
+    double toi;
+} Collision;
+
+/**
+ * Implementations of the batched seperating axis test.
+ */
+typedef enum {
+    // One axis at a time.
+    SAT_KERNEL_SCALAR,
+    // Two axes at a time with SSE2.
+    SAT_KERNEL_SSE2,
+    // Four axes at a time with AVX2.
+    SAT_KERNEL_AVX2
+} SatKernel;
+
+/**
+ * Test many pairs of hulls for collision with the seperating axis theorem.
+ * 
+ * Every vertex of both hulls is projected onto several of the pair's axes at
+ * once using the widest vector instructions the CPU supports, which is
+ * detected on first use.
+ * 
+ * Axes are numbered by counting the axes of the first hull of a pair then
+ * the second. If axis hints are given, the hinted axis of each pair is tested
+ * alone before the rest, and the pair is rejected without testing the other
+ * axes if it seperates the hulls.
+ * 
+ * @param hulls The hulls, indexed by the pairs.
+ * @param pairs The pairs of hulls to test.
+ * @param n The number of pairs.
+ * @param axes The axis to test first for each pair, or -1 for none. Replaced
+ * by the seperating axis of each seperated pair, or the axis of least overlap
+ * of each colliding pair, to hint the next test of the pair. May be NULL.
+ * @param results The result of each pair, written in the order of pairs. The
+ * MTV is the translation of the pair's first hull. Seperated pairs have a
+ * zero MTV and a time of impact of 1, whichever kernel tested them.
+ */
+void sat_colliding_batch(
+    Hull *hulls,
+    Pair *pairs,
+    int n,
+    int *axes,
+    Collision *results
+);
+
+/**
+ * Find when two moving hulls first touch during an increment, assuming both
+ * only translate. Each hull's shadow on each axis sweeps linearly over the
+ * increment, so the hulls touch during the interval in which every pair of
+ * shadows overlaps.
+ * 
+ * Used to catch pairs that move further than their size in one increment and
+ * would otherwise pass through each other between tests.
+ * 
+ * @param A The first hull, at the end of the increment.
+ * @param a The displacement of the first hull over the increment.
+ * @param B The second hull, at the end of the increment.
+ * @param b The displacement of the second hull over the increment.
+ * @param toi Set to the fraction of the increment at which the hulls first
+ * touch, if they touch.
+ * 
+ * @returns True if the hulls touch during the increment, otherwise false.
+ */
+bool sat_time_of_impact(Hull *A, Vector a, Hull *B, Vector b, double *toi);
+
+/**
+ * Get the kernel used by sat_colliding_batch().
+ * 
+ * @returns The kernel in use.
+ */
+SatKernel sat_kernel();
+
+/**
+ * Select the kernel used by sat_colliding_batch(), such as to compare the
+ * kernels or to force the scalar kernel.
+ * 
+ * @param kernel The kernel to use.
+ * @returns True if the kernel is supported by the CPU and was selected,
+ * otherwise false and the kernel is unchanged.
+ */
+bool sat_select_kernel(SatKernel kernel);
+
+#endif // SAT_H
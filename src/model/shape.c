@@ -0,0 +1,103 @@
+#include "model/shape.h"
+
+#include "model/polygon.h"
+
+struct ShapeLibrary {
+    // The templates, an Array of ShapeTemplate.
+    Array *templates;
+    // The local space verticies and seperating axes of every template, Arrays
+    // of Vector.
+    Array *verticies;
+    Array *normals;
+};
+
+ShapeLibrary *shape_library_create()
+{
+    ShapeLibrary *library = malloc(sizeof(ShapeLibrary));
+    if (!library)
+        return NULL;
+
+    library->templates = array_create(sizeof(ShapeTemplate));
+    library->verticies = array_create(sizeof(Vector));
+    library->normals = array_create(sizeof(Vector));
+
+    if (!library->templates || !library->verticies || !library->normals) {
+        shape_library_destroy(library);
+        return NULL;
+    }
+
+    return library;
+}
+
+/**
+ * Append every element of one array of Vector to another.
+ * 
+ * @returns The range of the appended elements, with a negative offset on
+ * failure.
+ */
+static VertexRange shape_library_append(Array *buffer, Array *elements)
+{
+    VertexRange range = {array_length(buffer), array_length(elements)};
+
+    if (!array_append_n(buffer, array_data(elements), range.count))
+        range.offset = -1;
+
+    return range;
+}
+
+int shape_library_add(ShapeLibrary *library, Array *polygon)
+{
+    Array *normals = polygon_axes(polygon);
+    if (!normals)
+        return -1;
+
+    ShapeTemplate shape = {
+        shape_library_append(library->verticies, polygon),
+        shape_library_append(library->normals, normals),
+        polygon_radius(polygon)
+    };
+
+    array_destroy(normals);
+
+    if (shape.verticies.offset < 0 || shape.normals.offset < 0 ||
+        !array_push_back(library->templates, &shape)) {
+        return -1;
+    }
+
+    return array_length(library->templates) - 1;
+}
+
+ShapeTemplate *shape_library_get(ShapeLibrary *library, int index)
+{
+    return array_get(library->templates, index);
+}
+
+int shape_library_length(ShapeLibrary *library)
+{
+    return array_length(library->templates);
+}
+
+Vector *shape_library_verticies(ShapeLibrary *library)
+{
+    return array_data(library->verticies);
+}
+
+Vector *shape_library_normals(ShapeLibrary *library)
+{
+    return array_data(library->normals);
+}
+
+void shape_library_destroy(ShapeLibrary *library)
+{
+    if (!library)
+        return;
+
+    if (library->templates)
+        array_destroy(library->templates);
+    if (library->verticies)
+        array_destroy(library->verticies);
+    if (library->normals)
+        array_destroy(library->normals);
+
+    free(library);
+}
@@ -0,0 +1,89 @@
+#ifndef SHAPE_H
+#define SHAPE_H
+
+#include "util/array.h"
+#include "util/vector.h"
+#include "model/vertex_pool.h"
+
+/**
+ * The local space geometry of a shape, shared by every body with the shape.
+ */
+typedef struct {
+    // The range of the shape's verticies in the library's verticies.
+    VertexRange verticies;
+    // The range of the shape's seperating axes in the library's normals.
+    VertexRange normals;
+    // The distance from the origin to the furthest vertex.
+    double radius;
+} ShapeTemplate;
+
+/**
+ * A library of shape templates. Bodies refer to a template by index and
+ * scale it, rather than each holding a copy of its geometry, so many bodies
+ * of few shapes only store the shapes once.
+ */
+typedef struct ShapeLibrary ShapeLibrary;
+
+/**
+ * Create a new empty shape library.
+ * 
+ * @returns Pointer to the library, or NULL on failure.
+ */
+ShapeLibrary *shape_library_create();
+
+/**
+ * Add a template to the library, copying a polygon and calculating its
+ * seperating axes and bounding radius.
+ * 
+ * @param library The library.
+ * @param polygon The local space polygon of the shape, an Array of Vector.
+ * 
+ * @returns The index of the template, or -1 on failure.
+ */
+int shape_library_add(ShapeLibrary *library, Array *polygon);
+
+/**
+ * Get a template from the library.
+ * 
+ * @param library The library.
+ * @param index The index of the template.
+ * 
+ * @returns Pointer to the template, valid until a template is next added.
+ */
+ShapeTemplate *shape_library_get(ShapeLibrary *library, int index);
+
+/**
+ * Get the number of templates in the library.
+ * 
+ * @param library The library.
+ * @returns The number of templates.
+ */
+int shape_library_length(ShapeLibrary *library);
+
+/**
+ * Get the local space verticies of every template, indexed by the templates'
+ * vertex ranges.
+ * 
+ * @param library The library.
+ * @returns Pointer to the first vertex, valid until a template is next added.
+ */
+Vector *shape_library_verticies(ShapeLibrary *library);
+
+/**
+ * Get the local space seperating axes of every template, indexed by the
+ * templates' normal ranges.
+ * 
+ * @param library The library.
+ * @returns Pointer to the first axis, valid until a template is next added.
+ */
+Vector *shape_library_normals(ShapeLibrary *library);
+
+/**
+ * Deallocate a shape library. Using the library or its templates after this
+ * call is undefined.
+ * 
+ * @param library The library to destroy.
+ */
+void shape_library_destroy(ShapeLibrary *library);
+
+#endif // SHAPE_H
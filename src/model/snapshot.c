@@ -0,0 +1,168 @@
+#include "model/snapshot.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "SDL2/SDL.h"
+
+#include "model/contact.h"
+
+// Set in the shared index when a snapshot has been published that the reader
+// has not yet taken.
+#define SNAPSHOT_FRESH 4
+
+// Masks the shared index to the index of the snapshot.
+#define SNAPSHOT_INDEX 3
+
+struct SnapshotBuffer {
+    Snapshot snapshots[3];
+    // The index of the snapshot between the writer and the reader, with
+    // SNAPSHOT_FRESH set if it has been published and not yet read.
+    SDL_atomic_t shared;
+    // The index of the snapshot owned by the writer, and by the reader.
+    int back;
+    int front;
+};
+
+SnapshotBuffer *snapshot_buffer_create()
+{
+    SnapshotBuffer *buffer = malloc(sizeof(SnapshotBuffer));
+    if (!buffer)
+        return NULL;
+
+    for (int i = 0; i < 3; i++) {
+        Snapshot *snapshot = buffer->snapshots + i;
+        snapshot->asteroids = array_create(sizeof(SnapshotAsteroid));
+        snapshot->time = 0;
+        snapshot->step = 0.0;
+
+        if (!snapshot->asteroids) {
+            for (int j = 0; j < i; j++)
+                array_destroy(buffer->snapshots[j].asteroids);
+            free(buffer);
+            return NULL;
+        }
+    }
+
+    buffer->back = 0;
+    SDL_AtomicSet(&buffer->shared, 1);
+    buffer->front = 2;
+
+    return buffer;
+}
+
+Snapshot *snapshot_buffer_write(SnapshotBuffer *buffer)
+{
+    return buffer->snapshots + buffer->back;
+}
+
+void snapshot_buffer_publish(SnapshotBuffer *buffer)
+{
+    // Swap the filled snapshot with the shared one. SDL_AtomicSet() is not
+    // guaranteed to order other memory, so release the snapshot's contents
+    // before its index is visible, and acquire the snapshot taken back so
+    // that the reader has finished with it before it is overwritten.
+    SDL_MemoryBarrierRelease();
+    int shared = SDL_AtomicSet(&buffer->shared, buffer->back | SNAPSHOT_FRESH);
+    SDL_MemoryBarrierAcquire();
+    buffer->back = shared & SNAPSHOT_INDEX;
+}
+
+Snapshot *snapshot_buffer_read(SnapshotBuffer *buffer)
+{
+    // Only take the shared snapshot if it is newer than the one already held,
+    // otherwise the reader would swap back to an older snapshot.
+    if (SDL_AtomicGet(&buffer->shared) & SNAPSHOT_FRESH) {
+
+        // Release the reads of the held snapshot before handing it to the
+        // writer, and acquire the contents of the published snapshot.
+        SDL_MemoryBarrierRelease();
+        int shared = SDL_AtomicSet(&buffer->shared, buffer->front);
+        SDL_MemoryBarrierAcquire();
+        buffer->front = shared & SNAPSHOT_INDEX;
+    }
+
+    return buffer->snapshots + buffer->front;
+}
+
+void snapshot_buffer_destroy(SnapshotBuffer *buffer)
+{
+    if (!buffer)
+        return;
+
+    for (int i = 0; i < 3; i++)
+        array_destroy(buffer->snapshots[i].asteroids);
+
+    free(buffer);
+}
+
+bool snapshot_capture(
+    Snapshot *snapshot,
+    AsteroidStore *store,
+    Array *contacts
+) {
+    int n = asteroid_store_length(store);
+    if (!array_resize(snapshot->asteroids, n))
+        return false;
+
+    Vector *previous_position = array_data(store->previous_position);
+    Vector *position = array_data(store->position);
+    double *previous_angle = array_data(store->previous_angle);
+    double *angle = array_data(store->angle);
+    int *shape = array_data(store->shape);
+    double *scale = array_data(store->scale);
+
+    SnapshotAsteroid *asteroids = array_data(snapshot->asteroids);
+    for (int i = 0; i < n; i++) {
+        *(asteroids + i) = (SnapshotAsteroid){
+            *(previous_position + i),
+            *(position + i),
+            *(previous_angle + i),
+            *(angle + i),
+            *(shape + i),
+            *(scale + i),
+            false
+        };
+    }
+
+    Contact *contact = array_data(contacts);
+    for (int i = 0; i < array_length(contacts); i++) {
+        if ((contact + i)->pair.a < n)
+            (asteroids + (contact + i)->pair.a)->colliding = true;
+        if ((contact + i)->pair.b < n)
+            (asteroids + (contact + i)->pair.b)->colliding = true;
+    }
+
+    return true;
+}
+
+int snapshot_interpolate(
+    Snapshot *snapshot,
+    ShapeLibrary *shapes,
+    int index,
+    double alpha,
+    Vector *verticies
+) {
+    SnapshotAsteroid *asteroid = snapshot_asteroid(snapshot, index);
+
+    Vector from = asteroid->previous_position;
+    Vector to = asteroid->position;
+    Vector delta = vector_scale(vector_sub(to, from), alpha);
+    Vector position = vector_add(from, delta);
+    double angle = asteroid->previous_angle
+        + (asteroid->angle - asteroid->previous_angle) * alpha;
+
+    ShapeTemplate *template = shape_library_get(shapes, asteroid->shape);
+    Vector *local = shape_library_verticies(shapes)
+        + template->verticies.offset;
+
+    double c = cos(angle) * asteroid->scale;
+    double s = sin(angle) * asteroid->scale;
+    for (int j = 0; j < template->verticies.count; j++)
+        *(verticies + j) = vector_add(
+            vector_rot_cs(*(local + j), c, s),
+            position
+        );
+
+    return template->verticies.count;
+}
@@ -0,0 +1,150 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+
+#include "util/array.h"
+#include "util/time.h"
+#include "util/vector.h"
+#include "model/asteroid_store.h"
+#include "model/shape.h"
+
+/**
+ * The state of an asteroid needed to draw it, at the end of a step.
+ */
+typedef struct {
+    // The position and angle of the asteroid at the start and end of the
+    // step, for interpolating between them.
+    Vector previous_position;
+    Vector position;
+    double previous_angle;
+    double angle;
+    // The shape template index and scale of the asteroid.
+    int shape;
+    double scale;
+    // Whether the asteroid was found colliding during the step.
+    bool colliding;
+} SnapshotAsteroid;
+
+/**
+ * An immutable copy of the model's drawable state, published at the end of a
+ * step.
+ */
+typedef struct {
+    // The state of each asteroid, an Array of SnapshotAsteroid.
+    Array *asteroids;
+    // The global time the snapshot was published, and the length of the step
+    // it ends in seconds.
+    Time time;
+    double step;
+} Snapshot;
+
+/**
+ * A triple buffer of snapshots for passing the model's state from the model's
+ * thread to the view's thread without either waiting on the other.
+ * 
+ * The writer fills its own snapshot and publishes it by atomically swapping it
+ * with the shared snapshot. The reader takes the shared snapshot by swapping
+ * it with its own only when a newer one has been published. Neither thread
+ * ever touches the snapshot the other owns, so the reader always sees a
+ * complete snapshot and the writer is never held up by drawing.
+ * 
+ * Thread safe for one writer and one reader.
+ */
+typedef struct SnapshotBuffer SnapshotBuffer;
+
+/**
+ * Create a new snapshot buffer with empty snapshots.
+ * 
+ * @returns Pointer to the snapshot buffer, or NULL on failure.
+ */
+SnapshotBuffer *snapshot_buffer_create();
+
+/**
+ * Get the snapshot owned by the writer, to be filled before publishing. Only
+ * called by the writer.
+ * 
+ * @param buffer The snapshot buffer.
+ * @returns The writer's snapshot.
+ */
+Snapshot *snapshot_buffer_write(SnapshotBuffer *buffer);
+
+/**
+ * Publish the writer's snapshot, making it the latest for the reader, and
+ * give the writer another snapshot to fill. Lock free. Only called by the
+ * writer.
+ * 
+ * @param buffer The snapshot buffer.
+ */
+void snapshot_buffer_publish(SnapshotBuffer *buffer);
+
+/**
+ * Get the latest published snapshot. The snapshot stays valid and unchanged
+ * until the reader next calls this function. Lock free. Only called by the
+ * reader.
+ * 
+ * @param buffer The snapshot buffer.
+ * @returns The latest snapshot, which is empty if none has been published.
+ */
+Snapshot *snapshot_buffer_read(SnapshotBuffer *buffer);
+
+/**
+ * Deallocate a snapshot buffer and its snapshots. Using the buffer after this
+ * call is undefined.
+ * 
+ * @param buffer The snapshot buffer to destroy.
+ */
+void snapshot_buffer_destroy(SnapshotBuffer *buffer);
+
+/**
+ * Copy the drawable state of every asteroid in a store into a snapshot.
+ * 
+ * @param snapshot The snapshot to fill.
+ * @param store The asteroids, saved at the start of the step.
+ * @param contacts The pairs found colliding during the step, an Array of
+ * Contact.
+ * 
+ * @returns True on success, false if the snapshot could not be resized.
+ */
+bool snapshot_capture(
+    Snapshot *snapshot,
+    AsteroidStore *store,
+    Array *contacts
+);
+
+/**
+ * Get an asteroid of a snapshot.
+ * 
+ * @param snapshot The snapshot.
+ * @param index The index of the asteroid in the snapshot.
+ * 
+ * @returns Pointer to the asteroid's state.
+ */
+static inline SnapshotAsteroid *snapshot_asteroid(Snapshot *snapshot, int index)
+{
+    return (SnapshotAsteroid*)array_data(snapshot->asteroids) + index;
+}
+
+/**
+ * Calculate the world space verticies of an asteroid in a snapshot at a state
+ * between the start and end of the snapshot's step.
+ * 
+ * @param snapshot The snapshot.
+ * @param shapes The shape templates of the asteroids.
+ * @param index The index of the asteroid in the snapshot.
+ * @param alpha How far between the start of the step, at 0, and its end, at
+ * 1, to place the asteroid.
+ * @param verticies Buffer to write the verticies to, with space for as many
+ * verticies as the asteroid's shape.
+ * 
+ * @returns The number of verticies written.
+ */
+int snapshot_interpolate(
+    Snapshot *snapshot,
+    ShapeLibrary *shapes,
+    int index,
+    double alpha,
+    Vector *verticies
+);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,230 @@
+#include "model/sweep.h"
+
+#include "util/hashmap.h"
+#include "model/broadphase.h"
+
+// A minimum or maximum x extent of a body.
+typedef struct {
+    // The x coordinate of the endpoint.
+    double value;
+    // The body the endpoint belongs to.
+    int body;
+    // Whether this is the body's maximum endpoint, otherwise its minimum.
+    bool max;
+} Endpoint;
+
+struct SweepAndPrune {
+    // Endpoints of all bodies sorted by value, with minimums before maximums
+    // of equal value.
+    Endpoint *endpoints;
+    // Scratch buffer of the bodies containing the sweep position during a
+    // rebuild.
+    int *active;
+    // The number of bodies, and the most bodies the buffers can hold.
+    int n;
+    int capacity;
+    // The set of pairs whose x extents overlap, keyed by pair_key().
+    HashMap *overlaps;
+};
+
+SweepAndPrune *sweep_create()
+{
+    SweepAndPrune *sweep = malloc(sizeof(SweepAndPrune));
+    if (!sweep)
+        return NULL;
+
+    sweep->overlaps = hashmap_create(0);
+    if (!sweep->overlaps) {
+        free(sweep);
+        return NULL;
+    }
+
+    sweep->endpoints = NULL;
+    sweep->active = NULL;
+    sweep->n = 0;
+    sweep->capacity = 0;
+
+    return sweep;
+}
+
+static inline bool sweep_before(Endpoint a, Endpoint b)
+{
+    // Minimums sort before maximums of equal value, so that touching extents
+    // are overlapping.
+    return a.value < b.value || (a.value == b.value && !a.max && b.max);
+}
+
+static int sweep_endpoint_compare(const void *a, const void *b)
+{
+    const Endpoint *p = a;
+    const Endpoint *q = b;
+
+    if (sweep_before(*p, *q))
+        return -1;
+    if (sweep_before(*q, *p))
+        return 1;
+
+    return 0;
+}
+
+static bool sweep_reserve(SweepAndPrune *sweep, int n)
+{
+    // Only grow the buffers, so that bodies coming and going does not touch
+    // the heap once the buffers are large enough.
+    if (n <= sweep->capacity)
+        return true;
+
+    Endpoint *endpoints = realloc(sweep->endpoints, 2 * n * sizeof(Endpoint));
+    if (endpoints)
+        sweep->endpoints = endpoints;
+
+    int *active = realloc(sweep->active, n * sizeof(int));
+    if (active)
+        sweep->active = active;
+
+    if (!endpoints || !active)
+        return false;
+
+    sweep->capacity = n;
+    return true;
+}
+
+static bool sweep_rebuild(SweepAndPrune *sweep, AABB *bounds, int n)
+{
+    if (!sweep_reserve(sweep, n)) {
+        sweep->n = 0;
+        return false;
+    }
+
+    Endpoint *endpoints = sweep->endpoints;
+    int *active = sweep->active;
+
+    for (int i = 0; i < n; i++) {
+        endpoints[2 * i] = (Endpoint){bounds[i].min.x, i, false};
+        endpoints[2 * i + 1] = (Endpoint){bounds[i].max.x, i, true};
+    }
+
+    // The endpoints are unsorted, so sort them outright rather than by
+    // insertion.
+    qsort(endpoints, 2 * n, sizeof(Endpoint), sweep_endpoint_compare);
+
+    // Sweep along the sorted endpoints keeping the bodies whose extent
+    // contains the sweep position. Each body starting pairs with every body
+    // in the active set.
+    hashmap_clear(sweep->overlaps);
+
+    int n_active = 0;
+
+    for (int e = 0; e < 2 * n; e++) {
+        int body = endpoints[e].body;
+
+        if (!endpoints[e].max) {
+            for (int k = 0; k < n_active; k++) {
+                Pair pair = pair_create(body, active[k]);
+                if (!hashmap_insert(sweep->overlaps, pair_key(pair), NULL)) {
+                    sweep->n = 0;
+                    return false;
+                }
+            }
+            active[n_active++] = body;
+        }
+        else {
+            for (int k = 0; k < n_active; k++) {
+                if (active[k] == body) {
+                    active[k] = active[--n_active];
+                    break;
+                }
+            }
+        }
+    }
+
+    sweep->n = n;
+    return true;
+}
+
+static bool sweep_sort(SweepAndPrune *sweep, AABB *bounds)
+{
+    Endpoint *endpoints = sweep->endpoints;
+    int n = 2 * sweep->n;
+
+    // Move the endpoints to the bodies' new extents.
+    for (int e = 0; e < n; e++) {
+        AABB *box = bounds + endpoints[e].body;
+        endpoints[e].value = endpoints[e].max ? box->max.x : box->min.x;
+    }
+
+    // Insertion sort. Each endpoint moving left past another swaps with it,
+    // and a swap between a minimum and a maximum changes whether their bodies
+    // overlap.
+    for (int i = 1; i < n; i++) {
+
+        Endpoint key = endpoints[i];
+        int j = i - 1;
+
+        while (j >= 0 && sweep_before(key, endpoints[j])) {
+
+            Endpoint other = endpoints[j];
+
+            if (key.max != other.max) {
+                Pair pair = pair_create(key.body, other.body);
+
+                // A minimum moving left past a maximum begins an overlap, and
+                // a maximum moving left past a minimum ends one.
+                if (!key.max) {
+                    if (!hashmap_insert(sweep->overlaps, pair_key(pair), NULL))
+                        return false;
+                }
+                else {
+                    hashmap_erase(sweep->overlaps, pair_key(pair));
+                }
+            }
+
+            endpoints[j + 1] = other;
+            j--;
+        }
+
+        endpoints[j + 1] = key;
+    }
+
+    return true;
+}
+
+bool sweep_pairs(SweepAndPrune *sweep, AABB *bounds, int n, Array *pairs)
+{
+    // Rebuild whenever bodies are added or removed, or if the last increment
+    // failed and the overlaps can no longer be trusted.
+    if (n != sweep->n) {
+        if (!sweep_rebuild(sweep, bounds, n))
+            return false;
+    }
+    else if (!sweep_sort(sweep, bounds)) {
+        sweep->n = 0;
+        return false;
+    }
+
+    // Pairs overlapping along x are only candidates if their boxes overlap.
+    int iterator = 0;
+    uint64_t key;
+    while (hashmap_next(sweep->overlaps, &iterator, &key, NULL)) {
+        Pair pair = pair_from_key(key);
+
+        if (!aabb_overlap(bounds[pair.a], bounds[pair.b]))
+            continue;
+
+        if (!pair_array_push_back(pairs, pair))
+            return false;
+    }
+
+    return true;
+}
+
+void sweep_destroy(SweepAndPrune *sweep)
+{
+    if (!sweep)
+        return;
+
+    free(sweep->endpoints);
+    free(sweep->active);
+    hashmap_destroy(sweep->overlaps);
+    free(sweep);
+}
@@ -0,0 +1,51 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "util/array.h"
+#include "model/aabb.h"
+
+/**
+ * An incremental sweep and prune broad phase.
+ * 
+ * The minimum and maximum x extents of every body are kept in a single sorted
+ * endpoint array between increments. Bodies move little between increments,
+ * so the array is nearly sorted and is re-sorted with an insertion sort. Every
+ * swap of a minimum endpoint with a maximum endpoint begins or ends an overlap
+ * along the x axis, so the set of overlapping pairs is maintained from the
+ * swaps alone rather than recomputed. The cost is close to O(n + k) for n
+ * bodies and k overlapping pairs.
+ */
+typedef struct SweepAndPrune SweepAndPrune;
+
+/**
+ * Create a new sweep and prune broad phase.
+ * 
+ * @returns A pointer to the sweep and prune, or NULL on failure.
+ */
+SweepAndPrune *sweep_create();
+
+/**
+ * Update the endpoints with the provided bounding boxes and find all pairs of
+ * boxes that overlap.
+ * 
+ * Bodies are identified by their index in bounds, which must refer to the same
+ * body between calls. If the number of bodies changes, the endpoints are
+ * rebuilt from scratch.
+ * 
+ * @param sweep The sweep and prune to update.
+ * @param bounds The bounding boxes of the bodies, indexed by body.
+ * @param n The number of bodies.
+ * @param pairs The Array of Pair to append the candidate pairs to.
+ * 
+ * @returns True on success, false on failure to allocate memory.
+ */
+bool sweep_pairs(SweepAndPrune *sweep, AABB *bounds, int n, Array *pairs);
+
+/**
+ * Deallocate a sweep and prune. Using it after this call is undefined.
+ * 
+ * @param sweep The sweep and prune to destroy.
+ */
+void sweep_destroy(SweepAndPrune *sweep);
+
+#endif // SWEEP_H
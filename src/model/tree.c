@@ -0,0 +1,548 @@
+#include "model/tree.h"
+
+#include <stdlib.h>
+
+// Null node index.
+#define NIL -1
+
+// The maximum depth of the traversal stack. A balanced tree of 2^31 leaves
+// is under 64 deep, so this is never reached.
+#define AABB_TREE_STACK 128
+
+// A node in the tree. Leaves have no children.
+typedef struct {
+    // The fattened box of a leaf, or the union of the children's boxes.
+    AABB bounds;
+    // Parent node, or the next free node when the node is free.
+    int parent;
+    // Children of an internal node, NIL for leaves.
+    int left;
+    int right;
+    // Distance to the deepest leaf below the node. 0 for leaves, -1 for free
+    // nodes.
+    int height;
+    // User data of a leaf.
+    int data;
+} AABBTreeNode;
+
+struct AABBTree {
+    // Node storage. Nodes refer to each other by index so that the storage
+    // can be reallocated.
+    AABBTreeNode *nodes;
+    // The number of nodes allocated.
+    int capacity;
+    // The root node.
+    int root;
+    // Head of the list of free nodes.
+    int free;
+};
+
+AABBTree *aabb_tree_create()
+{
+    AABBTree *tree = malloc(sizeof(AABBTree));
+    if (!tree)
+        return NULL;
+
+    tree->nodes = NULL;
+    tree->capacity = 0;
+    tree->root = NIL;
+    tree->free = NIL;
+
+    return tree;
+}
+
+static int aabb_tree_allocate(AABBTree *tree)
+{
+    // Double the node storage when there are no free nodes left, and thread
+    // the new nodes onto the free list.
+    if (tree->free == NIL) {
+        int capacity = tree->capacity ? tree->capacity << 1 : 16;
+
+        AABBTreeNode *nodes = realloc(
+            tree->nodes,
+            capacity * sizeof(AABBTreeNode)
+        );
+        if (!nodes)
+            return NIL;
+
+        for (int i = tree->capacity; i < capacity; i++) {
+            nodes[i].parent = i + 1 < capacity ? i + 1 : NIL;
+            nodes[i].height = -1;
+        }
+
+        tree->nodes = nodes;
+        tree->free = tree->capacity;
+        tree->capacity = capacity;
+    }
+
+    int index = tree->free;
+    AABBTreeNode *node = tree->nodes + index;
+
+    tree->free = node->parent;
+    node->parent = NIL;
+    node->left = NIL;
+    node->right = NIL;
+    node->height = 0;
+    node->data = 0;
+
+    return index;
+}
+
+static void aabb_tree_release(AABBTree *tree, int index)
+{
+    tree->nodes[index].parent = tree->free;
+    tree->nodes[index].height = -1;
+    tree->free = index;
+}
+
+static inline int max_int(int a, int b)
+{
+    return a > b ? a : b;
+}
+
+static int aabb_tree_balance(AABBTree *tree, int a)
+{
+    // Perform a left or right rotation if node a is imbalanced, returning the
+    // new root of the subtree.
+    AABBTreeNode *nodes = tree->nodes;
+    AABBTreeNode *A = nodes + a;
+
+    if (A->left == NIL || A->height < 2)
+        return a;
+
+    int b = A->left;
+    int c = A->right;
+    AABBTreeNode *B = nodes + b;
+    AABBTreeNode *C = nodes + c;
+
+    int balance = C->height - B->height;
+
+    // Rotate C up.
+    if (balance > 1) {
+        int f = C->left;
+        int g = C->right;
+        AABBTreeNode *F = nodes + f;
+        AABBTreeNode *G = nodes + g;
+
+        // Swap A and C.
+        C->left = a;
+        C->parent = A->parent;
+        A->parent = c;
+
+        // A's old parent should point to C.
+        if (C->parent != NIL) {
+            if (nodes[C->parent].left == a)
+                nodes[C->parent].left = c;
+            else
+                nodes[C->parent].right = c;
+        }
+        else {
+            tree->root = c;
+        }
+
+        // Keep the taller of C's children under C, and give the other to A.
+        if (F->height > G->height) {
+            C->right = f;
+            A->right = g;
+            G->parent = a;
+            A->bounds = aabb_union(B->bounds, G->bounds);
+            C->bounds = aabb_union(A->bounds, F->bounds);
+            A->height = 1 + max_int(B->height, G->height);
+            C->height = 1 + max_int(A->height, F->height);
+        }
+        else {
+            C->right = g;
+            A->right = f;
+            F->parent = a;
+            A->bounds = aabb_union(B->bounds, F->bounds);
+            C->bounds = aabb_union(A->bounds, G->bounds);
+            A->height = 1 + max_int(B->height, F->height);
+            C->height = 1 + max_int(A->height, G->height);
+        }
+
+        return c;
+    }
+
+    // Rotate B up.
+    if (balance < -1) {
+        int d = B->left;
+        int e = B->right;
+        AABBTreeNode *D = nodes + d;
+        AABBTreeNode *E = nodes + e;
+
+        // Swap A and B.
+        B->left = a;
+        B->parent = A->parent;
+        A->parent = b;
+
+        // A's old parent should point to B.
+        if (B->parent != NIL) {
+            if (nodes[B->parent].left == a)
+                nodes[B->parent].left = b;
+            else
+                nodes[B->parent].right = b;
+        }
+        else {
+            tree->root = b;
+        }
+
+        // Keep the taller of B's children under B, and give the other to A.
+        if (D->height > E->height) {
+            B->right = d;
+            A->left = e;
+            E->parent = a;
+            A->bounds = aabb_union(C->bounds, E->bounds);
+            B->bounds = aabb_union(A->bounds, D->bounds);
+            A->height = 1 + max_int(C->height, E->height);
+            B->height = 1 + max_int(A->height, D->height);
+        }
+        else {
+            B->right = e;
+            A->left = d;
+            D->parent = a;
+            A->bounds = aabb_union(C->bounds, D->bounds);
+            B->bounds = aabb_union(A->bounds, E->bounds);
+            A->height = 1 + max_int(C->height, D->height);
+            B->height = 1 + max_int(A->height, E->height);
+        }
+
+        return b;
+    }
+
+    return a;
+}
+
+static void aabb_tree_refit(AABBTree *tree, int index)
+{
+    // Walk back up to the root, rebalancing and recalculating the boxes and
+    // heights of every ancestor.
+    AABBTreeNode *nodes = tree->nodes;
+
+    while (index != NIL) {
+        index = aabb_tree_balance(tree, index);
+
+        AABBTreeNode *node = nodes + index;
+        AABBTreeNode *left = nodes + node->left;
+        AABBTreeNode *right = nodes + node->right;
+
+        node->height = 1 + max_int(left->height, right->height);
+        node->bounds = aabb_union(left->bounds, right->bounds);
+
+        index = node->parent;
+    }
+}
+
+static void aabb_tree_insert_leaf(AABBTree *tree, int leaf)
+{
+    AABBTreeNode *nodes = tree->nodes;
+
+    if (tree->root == NIL) {
+        tree->root = leaf;
+        nodes[leaf].parent = NIL;
+        return;
+    }
+
+    // Descend the tree to find the best sibling for the leaf, being the node
+    // whose union with the leaf increases the perimeter of the tree least.
+    AABB bounds = nodes[leaf].bounds;
+    int index = tree->root;
+
+    while (nodes[index].left != NIL) {
+        AABBTreeNode *node = nodes + index;
+        int left = node->left;
+        int right = node->right;
+
+        double perimeter = aabb_perimeter(node->bounds);
+        double combined = aabb_perimeter(aabb_union(node->bounds, bounds));
+
+        // Cost of creating a new parent for this node and the leaf.
+        double cost = 2.0 * combined;
+
+        // Minimum cost of pushing the leaf further down the tree, which grows
+        // this node by the leaf.
+        double inheritance = 2.0 * (combined - perimeter);
+
+        AABB left_union = aabb_union(bounds, nodes[left].bounds);
+        double cost_left = aabb_perimeter(left_union);
+        if (nodes[left].left != NIL)
+            cost_left -= aabb_perimeter(nodes[left].bounds);
+        cost_left += inheritance;
+
+        AABB right_union = aabb_union(bounds, nodes[right].bounds);
+        double cost_right = aabb_perimeter(right_union);
+        if (nodes[right].left != NIL)
+            cost_right -= aabb_perimeter(nodes[right].bounds);
+        cost_right += inheritance;
+
+        if (cost < cost_left && cost < cost_right)
+            break;
+
+        index = cost_left < cost_right ? left : right;
+    }
+
+    int sibling = index;
+
+    // Create a new parent for the leaf and its sibling. Allocating may move
+    // the node storage.
+    int parent = aabb_tree_allocate(tree);
+    nodes = tree->nodes;
+
+    int grandparent = nodes[sibling].parent;
+    nodes[parent].parent = grandparent;
+    nodes[parent].bounds = aabb_union(bounds, nodes[sibling].bounds);
+    nodes[parent].height = nodes[sibling].height + 1;
+    nodes[parent].left = sibling;
+    nodes[parent].right = leaf;
+    nodes[sibling].parent = parent;
+    nodes[leaf].parent = parent;
+
+    if (grandparent != NIL) {
+        if (nodes[grandparent].left == sibling)
+            nodes[grandparent].left = parent;
+        else
+            nodes[grandparent].right = parent;
+    }
+    else {
+        tree->root = parent;
+    }
+
+    aabb_tree_refit(tree, parent);
+}
+
+static void aabb_tree_remove_leaf(AABBTree *tree, int leaf)
+{
+    AABBTreeNode *nodes = tree->nodes;
+
+    if (leaf == tree->root) {
+        tree->root = NIL;
+        return;
+    }
+
+    // Replace the leaf's parent with the leaf's sibling.
+    int parent = nodes[leaf].parent;
+    int grandparent = nodes[parent].parent;
+    int sibling = nodes[parent].left == leaf
+        ? nodes[parent].right
+        : nodes[parent].left;
+
+    aabb_tree_release(tree, parent);
+
+    if (grandparent != NIL) {
+        if (nodes[grandparent].left == parent)
+            nodes[grandparent].left = sibling;
+        else
+            nodes[grandparent].right = sibling;
+
+        nodes[sibling].parent = grandparent;
+        aabb_tree_refit(tree, grandparent);
+    }
+    else {
+        tree->root = sibling;
+        nodes[sibling].parent = NIL;
+    }
+}
+
+int aabb_tree_insert(AABBTree *tree, AABB bounds, int data)
+{
+    int proxy = aabb_tree_allocate(tree);
+    if (proxy == NIL)
+        return NIL;
+
+    tree->nodes[proxy].bounds = aabb_fatten(bounds, AABB_TREE_MARGIN);
+    tree->nodes[proxy].data = data;
+
+    // The tree can hold at most twice as many nodes as leaves, so ensure the
+    // parent created by insertion can be allocated before linking the leaf.
+    int parent = aabb_tree_allocate(tree);
+    if (parent == NIL) {
+        aabb_tree_release(tree, proxy);
+        return NIL;
+    }
+    aabb_tree_release(tree, parent);
+
+    aabb_tree_insert_leaf(tree, proxy);
+    return proxy;
+}
+
+void aabb_tree_remove(AABBTree *tree, int proxy)
+{
+    aabb_tree_remove_leaf(tree, proxy);
+    aabb_tree_release(tree, proxy);
+}
+
+bool aabb_tree_move(AABBTree *tree, int proxy, AABB bounds, Vector displacement)
+{
+    AABBTreeNode *node = tree->nodes + proxy;
+
+    // Predict where the body is heading by extending its fattened box in the
+    // direction of its displacement.
+    AABB fat = aabb_fatten(bounds, AABB_TREE_MARGIN);
+    Vector d = vector_scale(displacement, AABB_TREE_DISPLACEMENT);
+
+    if (d.x < 0.0)
+        fat.min.x += d.x;
+    else
+        fat.max.x += d.x;
+
+    if (d.y < 0.0)
+        fat.min.y += d.y;
+    else
+        fat.max.y += d.y;
+
+    // The leaf does not need to move if it is still inside its fattened box,
+    // unless the box is far too large, such as after the body slowed down.
+    AABB huge = aabb_fatten(fat, 4.0 * AABB_TREE_MARGIN);
+    if (aabb_contains(node->bounds, bounds) &&
+        aabb_contains(huge, node->bounds)) {
+        return false;
+    }
+
+    // The leaf's parent is released before it is reinserted, so reinsertion
+    // never needs to allocate.
+    aabb_tree_remove_leaf(tree, proxy);
+    tree->nodes[proxy].bounds = fat;
+    aabb_tree_insert_leaf(tree, proxy);
+
+    return true;
+}
+
+void aabb_tree_set_data(AABBTree *tree, int proxy, int data)
+{
+    tree->nodes[proxy].data = data;
+}
+
+AABB aabb_tree_bounds(AABBTree *tree, int proxy)
+{
+    return tree->nodes[proxy].bounds;
+}
+
+void aabb_tree_query(
+    AABBTree *tree,
+    AABB bounds,
+    AABBTreeQueryFunction func,
+    void *context
+) {
+    int stack[AABB_TREE_STACK];
+    int n = 0;
+
+    if (tree->root != NIL)
+        stack[n++] = tree->root;
+
+    while (n > 0) {
+        AABBTreeNode *node = tree->nodes + stack[--n];
+
+        if (!aabb_overlap(node->bounds, bounds))
+            continue;
+
+        if (node->left == NIL) {
+            if (!func(node->data, context))
+                return;
+        }
+        else if (n + 2 <= AABB_TREE_STACK) {
+            stack[n++] = node->left;
+            stack[n++] = node->right;
+        }
+    }
+}
+
+static bool aabb_ray_overlap(
+    AABB box,
+    Vector from,
+    Vector delta,
+    double fraction
+) {
+    // Clip the ray's fraction interval against each pair of box sides (slab
+    // test).
+    double low = 0.0;
+    double high = fraction;
+
+    double origin[2] = {from.x, from.y};
+    double direction[2] = {delta.x, delta.y};
+    double min[2] = {box.min.x, box.min.y};
+    double max[2] = {box.max.x, box.max.y};
+
+    for (int i = 0; i < 2; i++) {
+        if (direction[i] == 0.0) {
+            if (origin[i] < min[i] || origin[i] > max[i])
+                return false;
+            continue;
+        }
+
+        double t1 = (min[i] - origin[i]) / direction[i];
+        double t2 = (max[i] - origin[i]) / direction[i];
+        if (t1 > t2) {
+            double t = t1;
+            t1 = t2;
+            t2 = t;
+        }
+
+        if (t1 > low)
+            low = t1;
+        if (t2 < high)
+            high = t2;
+        if (low > high)
+            return false;
+    }
+
+    return true;
+}
+
+void aabb_tree_ray_cast(
+    AABBTree *tree,
+    Vector from,
+    Vector to,
+    AABBTreeRayCastFunction func,
+    void *context
+) {
+    Vector delta = vector_sub(to, from);
+    double fraction = 1.0;
+
+    int stack[AABB_TREE_STACK];
+    int n = 0;
+
+    if (tree->root != NIL)
+        stack[n++] = tree->root;
+
+    while (n > 0) {
+        AABBTreeNode *node = tree->nodes + stack[--n];
+
+        if (!aabb_ray_overlap(node->bounds, from, delta, fraction))
+            continue;
+
+        if (node->left == NIL) {
+            fraction = func(node->data, fraction, context);
+            if (fraction <= 0.0)
+                return;
+        }
+        else if (n + 2 <= AABB_TREE_STACK) {
+            stack[n++] = node->left;
+            stack[n++] = node->right;
+        }
+    }
+}
+
+void aabb_tree_clear(AABBTree *tree)
+{
+    // Thread every node back onto the free list.
+    for (int i = 0; i < tree->capacity; i++) {
+        tree->nodes[i].parent = i + 1 < tree->capacity ? i + 1 : NIL;
+        tree->nodes[i].height = -1;
+    }
+
+    tree->root = NIL;
+    tree->free = tree->capacity ? 0 : NIL;
+}
+
+int aabb_tree_height(AABBTree *tree)
+{
+    return tree->root == NIL ? -1 : tree->nodes[tree->root].height;
+}
+
+void aabb_tree_destroy(AABBTree *tree)
+{
+    if (!tree)
+        return;
+
+    free(tree->nodes);
+    free(tree);
+}
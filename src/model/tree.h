@@ -0,0 +1,178 @@
+#ifndef TREE_H
+#define TREE_H
+
+#include <stdbool.h>
+
+#include "util/vector.h"
+#include "model/aabb.h"
+
+// Distance each side of a leaf's box is extended by, so that small movements
+// do not require the leaf to be reinserted.
+#define AABB_TREE_MARGIN 0.1
+
+// How many steps of displacement a leaf's box is extended by in the direction
+// it is moving.
+#define AABB_TREE_DISPLACEMENT 2.0
+
+/**
+ * A dynamic bounding volume hierarchy of axis aligned bounding boxes.
+ * 
+ * Each leaf holds the fattened box of a body, and each internal node holds the
+ * union of its children. Leaves are inserted next to the sibling that least
+ * increases the total perimeter of the tree, and the tree is kept balanced by
+ * rotating nodes on the path back to the root after every insertion and
+ * removal. Because leaves are fattened, moving bodies are only reinserted
+ * when they leave their fattened box, which suits fields of bodies of very
+ * different sizes better than a uniform grid.
+ * 
+ * Leaves are referred to by proxy identifiers returned on insertion.
+ */
+typedef struct AABBTree AABBTree;
+
+/**
+ * Function prototype to provide to aabb_tree_query.
+ * 
+ * @param data The data of a leaf whose box overlaps the query box.
+ * @param context The optional data forwarded from aabb_tree_query.
+ * 
+ * @returns True to continue the query, false to stop it.
+ */
+typedef bool(AABBTreeQueryFunction)(int data, void *context);
+
+/**
+ * Function prototype to provide to aabb_tree_ray_cast.
+ * 
+ * @param data The data of a leaf whose box is hit by the ray.
+ * @param fraction The current maximum fraction along the ray being cast.
+ * @param context The optional data forwarded from aabb_tree_ray_cast.
+ * 
+ * @returns The new maximum fraction along the ray to cast to. Return fraction
+ * to continue unchanged, a smaller fraction to clip the ray, or 0 to stop.
+ */
+typedef double(AABBTreeRayCastFunction)(
+    int data,
+    double fraction,
+    void *context
+);
+
+/**
+ * Create a new empty tree.
+ * 
+ * @returns A pointer to the tree, or NULL on failure.
+ */
+AABBTree *aabb_tree_create();
+
+/**
+ * Insert a leaf into the tree.
+ * 
+ * @param tree The tree to insert into.
+ * @param bounds The tight bounding box of the body.
+ * @param data Data to store with the leaf, returned by queries.
+ * 
+ * @returns The proxy identifying the leaf, or -1 on failure to allocate.
+ */
+int aabb_tree_insert(AABBTree *tree, AABB bounds, int data);
+
+/**
+ * Remove a leaf from the tree.
+ * 
+ * @param tree The tree to remove from.
+ * @param proxy The proxy of the leaf to remove.
+ */
+void aabb_tree_remove(AABBTree *tree, int proxy);
+
+/**
+ * Move a leaf to a new box. The leaf is only reinserted if the new box has
+ * left the fattened box, or the fattened box has become far too large.
+ * 
+ * @param tree The tree containing the leaf.
+ * @param proxy The proxy of the leaf to move.
+ * @param bounds The new tight bounding box of the body.
+ * @param displacement The body's displacement per step, used to predict where
+ * it is heading.
+ * 
+ * @returns True if the leaf was reinserted, otherwise false.
+ */
+bool aabb_tree_move(
+    AABBTree *tree,
+    int proxy,
+    AABB bounds,
+    Vector displacement
+);
+
+/**
+ * Set the data stored with a leaf.
+ * 
+ * @param tree The tree containing the leaf.
+ * @param proxy The proxy of the leaf.
+ * @param data The new data.
+ */
+void aabb_tree_set_data(AABBTree *tree, int proxy, int data);
+
+/**
+ * Get the fattened box stored for a leaf.
+ * 
+ * @param tree The tree containing the leaf.
+ * @param proxy The proxy of the leaf.
+ * 
+ * @returns The fattened box.
+ */
+AABB aabb_tree_bounds(AABBTree *tree, int proxy);
+
+/**
+ * Call a function with the data of every leaf whose fattened box overlaps the
+ * provided box.
+ * 
+ * @param tree The tree to query.
+ * @param bounds The box to query.
+ * @param func The function to call for each overlapping leaf.
+ * @param context Optional data to forward to the function.
+ */
+void aabb_tree_query(
+    AABBTree *tree,
+    AABB bounds,
+    AABBTreeQueryFunction func,
+    void *context
+);
+
+/**
+ * Call a function with the data of every leaf whose fattened box is hit by the
+ * line segment from one point to another.
+ * 
+ * @param tree The tree to cast into.
+ * @param from The start of the ray.
+ * @param to The end of the ray.
+ * @param func The function to call for each leaf hit.
+ * @param context Optional data to forward to the function.
+ */
+void aabb_tree_ray_cast(
+    AABBTree *tree,
+    Vector from,
+    Vector to,
+    AABBTreeRayCastFunction func,
+    void *context
+);
+
+/**
+ * Remove every leaf from the tree without freeing memory.
+ * 
+ * @param tree The tree to clear.
+ */
+void aabb_tree_clear(AABBTree *tree);
+
+/**
+ * Get the height of the tree. A tree with a single leaf has a height of 0.
+ * 
+ * @param tree The tree.
+ * @returns The height of the tree, or -1 if it is empty.
+ */
+int aabb_tree_height(AABBTree *tree);
+
+/**
+ * Deallocate a tree. Using the tree after this call is undefined.
+ * 
+ * @param tree The tree to destroy.
+ */
+void aabb_tree_destroy(AABBTree *tree);
+
+#endif // TREE_H
@@ -0,0 +1,79 @@
+#include "model/vertex_pool.h"
+
+#include <string.h>
+
+struct VertexPool {
+    // The verticies of every range.
+    Array *verticies;
+};
+
+VertexPool *vertex_pool_create()
+{
+    VertexPool *pool = malloc(sizeof(VertexPool));
+    if (!pool)
+        return NULL;
+
+    pool->verticies = array_create(sizeof(Vector));
+    if (!pool->verticies) {
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+VertexRange vertex_pool_allocate(VertexPool *pool, int count)
+{
+    VertexRange range = {array_length(pool->verticies), count};
+
+    if (!array_resize(pool->verticies, range.offset + count))
+        range.offset = -1;
+
+    return range;
+}
+
+bool vertex_pool_reserve(VertexPool *pool, int capacity)
+{
+    return array_reserve(pool->verticies, capacity);
+}
+
+bool vertex_pool_free(VertexPool *pool, VertexRange range)
+{
+    if (range.offset < 0 || range.count < 0 ||
+        range.offset + range.count > array_length(pool->verticies)) {
+        return false;
+    }
+
+    // Close the gap. The buffer is never shrunk, so that removing and adding
+    // shapes does not touch the heap once it is large enough.
+    Vector *verticies = array_data(pool->verticies);
+    int length = array_length(pool->verticies);
+    int end = range.offset + range.count;
+
+    memmove(
+        verticies + range.offset,
+        verticies + end,
+        (length - end) * sizeof(Vector)
+    );
+
+    return array_resize(pool->verticies, length - range.count);
+}
+
+Vector *vertex_pool_data(VertexPool *pool)
+{
+    return array_data(pool->verticies);
+}
+
+int vertex_pool_length(VertexPool *pool)
+{
+    return array_length(pool->verticies);
+}
+
+void vertex_pool_destroy(VertexPool *pool)
+{
+    if (!pool)
+        return;
+
+    array_destroy(pool->verticies);
+    free(pool);
+}
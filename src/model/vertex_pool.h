@@ -0,0 +1,110 @@
+#ifndef VERTEX_POOL_H
+#define VERTEX_POOL_H
+
+#include <stdbool.h>
+
+#include "util/array.h"
+#include "util/vector.h"
+
+/**
+ * A range of verticies of a shared buffer belonging to one shape.
+ */
+typedef struct {
+    // The index of the first vertex.
+    int offset;
+    // The number of verticies.
+    int count;
+} VertexRange;
+
+/**
+ * The world space verticies of many shapes, kept in one contiguous buffer so
+ * that transforming every shape streams linearly through it. Each shape
+ * refers to its verticies by range. The local space verticies the world space
+ * verticies are transformed from are kept by the shapes' templates.
+ * 
+ * Freeing a range moves every later vertex down to close the gap, so the
+ * buffer stays dense and the ranges after it must be moved down too.
+ */
+typedef struct VertexPool VertexPool;
+
+/**
+ * Create a new empty vertex pool.
+ * 
+ * @returns Pointer to the pool, or NULL on failure.
+ */
+VertexPool *vertex_pool_create();
+
+/**
+ * Allocate a range of uninitialised verticies at the end of the pool.
+ * 
+ * @param pool The pool.
+ * @param count The number of verticies.
+ * 
+ * @returns The allocated range, with a negative offset on failure.
+ */
+VertexRange vertex_pool_allocate(VertexPool *pool, int count);
+
+/**
+ * Grow the pool until it has capacity for a number of verticies, such that
+ * ranges totalling that many can be allocated without touching the heap.
+ * 
+ * @param pool The pool.
+ * @param capacity The number of verticies to have capacity for.
+ * 
+ * @returns True on success, false on failure to allocate.
+ */
+bool vertex_pool_reserve(VertexPool *pool, int capacity);
+
+/**
+ * Free a range of the pool, moving every later vertex down by the size of the
+ * range. Ranges with an offset after the freed range must be moved down with
+ * vertex_pool_compact_range().
+ * 
+ * @param pool The pool.
+ * @param range The range to free.
+ * 
+ * @returns True on success, false if the range is not in the pool.
+ */
+bool vertex_pool_free(VertexPool *pool, VertexRange range);
+
+/**
+ * Move a range down to account for a freed range, if it was after it.
+ * 
+ * @param range The range to move.
+ * @param freed The range that was freed.
+ * 
+ * @returns The range's new position.
+ */
+static inline VertexRange vertex_pool_compact_range(
+    VertexRange range,
+    VertexRange freed
+) {
+    if (range.offset > freed.offset)
+        range.offset -= freed.count;
+    return range;
+}
+
+/**
+ * Get the verticies of the pool.
+ * 
+ * @param pool The pool.
+ * @returns Pointer to the first vertex, valid until the pool is modified.
+ */
+Vector *vertex_pool_data(VertexPool *pool);
+
+/**
+ * Get the number of verticies in the pool.
+ * 
+ * @param pool The pool.
+ * @returns The number of allocated verticies.
+ */
+int vertex_pool_length(VertexPool *pool);
+
+/**
+ * Deallocate a vertex pool. Using the pool after this call is undefined.
+ * 
+ * @param pool The pool to destroy.
+ */
+void vertex_pool_destroy(VertexPool *pool);
+
+#endif // VERTEX_POOL_H
@@ -0,0 +1,214 @@
+#include "util/arena.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A block of memory that allocations are bumped from. Blocks are chained
+ * together when an arena overflows.
+ */
+typedef struct ArenaBlock {
+    // The block allocated before this one, or NULL if this is the first.
+    struct ArenaBlock *previous;
+    // The number of bytes in the block, and the number allocated.
+    size_t capacity;
+    size_t used;
+    // The memory of the block.
+    uint8_t *data;
+} ArenaBlock;
+
+struct Arena {
+    // The block being allocated from, the last in the chain.
+    ArenaBlock *block;
+    // If more blocks are allocated when the arena runs out of space.
+    bool chain;
+    // The last allocation, which can be resized in place.
+    uint8_t *last;
+    // The bytes used since the last reset, and the most ever used.
+    size_t used;
+    size_t high_water;
+};
+
+static ArenaBlock *arena_block_create(size_t capacity, ArenaBlock *previous)
+{
+    // Allocate the block header and its memory together.
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + capacity);
+    if (!block)
+        return NULL;
+
+    block->previous = previous;
+    block->capacity = capacity;
+    block->used = 0;
+    block->data = (uint8_t*)(block + 1);
+
+    return block;
+}
+
+Arena *arena_create(size_t capacity, bool chain)
+{
+    Arena *arena = malloc(sizeof(Arena));
+    if (!arena)
+        return NULL;
+
+    arena->block = arena_block_create(capacity, NULL);
+    if (!arena->block) {
+        free(arena);
+        return NULL;
+    }
+
+    arena->chain = chain;
+    arena->last = NULL;
+    arena->used = 0;
+    arena->high_water = 0;
+
+    return arena;
+}
+
+/**
+ * Get the offset into a block that an allocation with an alignment would
+ * start at.
+ */
+static size_t arena_block_align(ArenaBlock *block, size_t align)
+{
+    uintptr_t address = (uintptr_t)(block->data + block->used);
+    uintptr_t aligned = (address + align - 1) & ~(uintptr_t)(align - 1);
+    return block->used + (aligned - address);
+}
+
+void *arena_allocate(Arena *arena, size_t size, size_t align)
+{
+    assert(align > 0 && (align & (align - 1)) == 0);
+
+    ArenaBlock *block = arena->block;
+    size_t offset = arena_block_align(block, align);
+
+    if (offset + size > block->capacity) {
+
+        if (!arena->chain)
+            return NULL;
+
+        // Chain a block at least double the size of the last, and large
+        // enough for the allocation when aligned.
+        size_t capacity = block->capacity * 2;
+        if (capacity < size + align)
+            capacity = size + align;
+
+        block = arena_block_create(capacity, block);
+        if (!block)
+            return NULL;
+
+        arena->block = block;
+        offset = arena_block_align(block, align);
+    }
+
+    arena->used += offset + size - block->used;
+    if (arena->used > arena->high_water)
+        arena->high_water = arena->used;
+
+    block->used = offset + size;
+    arena->last = block->data + offset;
+
+    return arena->last;
+}
+
+void *arena_reallocate(
+    Arena *arena,
+    void *memory,
+    size_t size,
+    size_t new_size,
+    size_t align
+) {
+    if (!memory)
+        return arena_allocate(arena, new_size, align);
+
+    // Resize the last allocation in place if it fits in its block.
+    ArenaBlock *block = arena->block;
+    if (memory == arena->last) {
+        size_t offset = (uint8_t*)memory - block->data;
+        if (offset + new_size <= block->capacity) {
+            arena->used = arena->used - block->used + offset + new_size;
+            if (arena->used > arena->high_water)
+                arena->high_water = arena->used;
+
+            block->used = offset + new_size;
+            return memory;
+        }
+    }
+
+    if (new_size <= size)
+        return memory;
+
+    void *reallocated = arena_allocate(arena, new_size, align);
+    if (!reallocated)
+        return NULL;
+
+    memcpy(reallocated, memory, size);
+    return reallocated;
+}
+
+void arena_reset(Arena *arena)
+{
+    ArenaBlock *block = arena->block;
+
+    // Free the chained blocks, and grow the first block to hold everything
+    // they held so that the next increment fits in one block.
+    if (block->previous) {
+
+        size_t capacity = 0;
+        while (block->previous) {
+            ArenaBlock *previous = block->previous;
+            capacity += block->capacity;
+            free(block);
+            block = previous;
+        }
+        capacity += block->capacity;
+
+        // Keep the first block if the larger block could not be allocated.
+        ArenaBlock *merged = arena_block_create(capacity, NULL);
+        if (merged) {
+            free(block);
+            block = merged;
+        }
+    }
+
+    block->used = 0;
+    arena->block = block;
+    arena->last = NULL;
+    arena->used = 0;
+}
+
+size_t arena_used(Arena *arena)
+{
+    return arena->used;
+}
+
+size_t arena_capacity(Arena *arena)
+{
+    size_t capacity = 0;
+    for (ArenaBlock *block = arena->block; block; block = block->previous)
+        capacity += block->capacity;
+
+    return capacity;
+}
+
+size_t arena_high_water(Arena *arena)
+{
+    return arena->high_water;
+}
+
+void arena_destroy(Arena *arena)
+{
+    if (!arena)
+        return;
+
+    ArenaBlock *block = arena->block;
+    while (block) {
+        ArenaBlock *previous = block->previous;
+        free(block);
+        block = previous;
+    }
+
+    free(arena);
+}
@@ -0,0 +1,110 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * A bump allocator for short lived data. Allocating advances an offset into a
+ * block of memory, and every allocation is freed at once by resetting the
+ * arena, so data that only lives for one increment can be allocated without
+ * touching the heap.
+ * 
+ * When chaining is enabled an arena that runs out of space allocates another
+ * block rather than failing, and on reset the blocks are merged into one large
+ * enough for everything allocated since the last reset.
+ * 
+ * Not thread safe.
+ */
+typedef struct Arena Arena;
+
+/**
+ * Create a new arena.
+ * 
+ * @param capacity The number of bytes to allocate up front.
+ * @param chain If the arena should allocate more blocks when it runs out of
+ * space, otherwise allocations that do not fit fail.
+ * 
+ * @returns Pointer to the arena, or NULL on failure.
+ */
+Arena *arena_create(size_t capacity, bool chain);
+
+/**
+ * Allocate memory from the arena. The memory is valid until the arena is
+ * reset or destroyed.
+ * 
+ * @param arena The arena to allocate from.
+ * @param size The number of bytes to allocate.
+ * @param align The alignment of the memory, a power of 2.
+ * 
+ * @returns Pointer to the memory, or NULL if it did not fit in the arena or
+ * a new block could not be allocated.
+ */
+void *arena_allocate(Arena *arena, size_t size, size_t align);
+
+/**
+ * Grow or shrink memory allocated from the arena. The memory is resized in
+ * place when it was the last allocation and there is room in its block,
+ * otherwise new memory is allocated and the contents copied into it.
+ * 
+ * @param arena The arena the memory was allocated from.
+ * @param memory The memory to resize, or NULL to allocate new memory.
+ * @param size The current size of the memory in bytes.
+ * @param new_size The new size of the memory in bytes.
+ * @param align The alignment of the memory, a power of 2.
+ * 
+ * @returns Pointer to the resized memory, or NULL on failure, in which case
+ * the original memory is left untouched.
+ */
+void *arena_reallocate(
+    Arena *arena,
+    void *memory,
+    size_t size,
+    size_t new_size,
+    size_t align
+);
+
+/**
+ * Free everything allocated from the arena. If the arena overflowed into more
+ * blocks since the last reset, they are replaced by one block large enough
+ * for all of them.
+ * 
+ * @param arena The arena to reset.
+ */
+void arena_reset(Arena *arena);
+
+/**
+ * Get the number of bytes allocated from the arena since the last reset,
+ * including alignment padding.
+ * 
+ * @param arena The arena.
+ * @returns The number of bytes used.
+ */
+size_t arena_used(Arena *arena);
+
+/**
+ * Get the number of bytes the arena has allocated from the heap.
+ * 
+ * @param arena The arena.
+ * @returns The total capacity of the arena's blocks.
+ */
+size_t arena_capacity(Arena *arena);
+
+/**
+ * Get the high water mark of the arena, being the most bytes that have been
+ * used between two resets.
+ * 
+ * @param arena The arena.
+ * @returns The most bytes used at once.
+ */
+size_t arena_high_water(Arena *arena);
+
+/**
+ * Deallocate an arena and everything allocated from it. Using the arena or
+ * its memory after this call is undefined.
+ * 
+ * @param arena The arena to destroy.
+ */
+void arena_destroy(Arena *arena);
+
+#endif // ARENA_H
@@ -1,8 +1,37 @@
 #include "util/array.h"
 
 #include <assert.h>
+#include <stdalign.h>
+#include <stddef.h>
 #include <string.h>
 
+/**
+ * Get the size of an array header rounded up such that inline storage
+ * following it is aligned for any type.
+ */
+static inline size_t array_header_size()
+{
+    size_t align = alignof(max_align_t);
+    return (sizeof(Array) + align - 1) / align * align;
+}
+
+/**
+ * Get the inline storage of an array, which follows the header in the same
+ * allocation.
+ */
+static inline void *array_storage(Array *array)
+{
+    return (uint8_t*)array + array_header_size();
+}
+
+/**
+ * Check if the elements of an array are in its inline storage.
+ */
+static inline bool array_is_inline(Array *array)
+{
+    return array->inline_capacity > 0 && array->buffer == array_storage(array);
+}
+
 Array *array_create(size_t size)
 {
     assert(size > 0);
@@ -17,22 +46,61 @@ Array *array_create(size_t size)
     array->size = size;
     array->length = 0;
     array->capacity = 0;
+    array->inline_capacity = 0;
+    array->arena = NULL;
+
+    return array;
+}
+
+Array *array_create_inline(size_t size, int n)
+{
+    assert(size > 0 && n > 0);
+
+    // Allocate the array structure and its inline storage together.
+    Array *array = malloc(array_header_size() + size * n);
+    if (!array)
+        return NULL;
+
+    array->buffer = array_storage(array);
+    array->size = size;
+    array->length = 0;
+    array->capacity = n;
+    array->inline_capacity = n;
+    array->arena = NULL;
+
+    return array;
+}
+
+Array *array_create_arena(Arena *arena, size_t size)
+{
+    assert(size > 0);
+
+    Array *array = arena_allocate(arena, sizeof(Array), alignof(Array));
+    if (!array)
+        return NULL;
+
+    array->buffer = NULL;
+    array->size = size;
+    array->length = 0;
+    array->capacity = 0;
+    array->inline_capacity = 0;
+    array->arena = arena;
 
     return array;
 }
 
 Array *array_create_from_array(Array *array)
 {
-    Array *new = array_create(array->size);
+    // Copy into the same amount of inline storage as the original.
+    Array *new = array->inline_capacity
+        ? array_create_inline(array->size, array->inline_capacity)
+        : array_create(array->size);
     if (!new)
         return NULL;
 
-    // Set the size of the new array.
-    new->size = array->size;
-
     // Allocate enough space for the length of passed array.
     if (!array_allocate(new, array->length)) {
-        free(new);
+        array_destroy(new);
         return NULL;
     }
 
@@ -44,32 +112,98 @@ Array *array_create_from_array(Array *array)
     return new;
 }
 
-void array_reduce(Array *array)
+/**
+ * Change the capacity of an array, moving its elements between the inline
+ * storage, the heap and its arena as required. The capacity must be at least
+ * the length of the array.
+ * 
+ * @returns True on success, false on failure to allocate, in which case the
+ * array is unchanged.
+ */
+static bool array_reallocate(Array *array, int capacity)
 {
-    // Check if we can free memory. Occurs when we have enough elements to fit
-    // into the below power of 2 capacity.
+    // Arrays in an arena grow within the arena.
+    if (array->arena) {
+        void *reallocated = arena_reallocate(
+            array->arena,
+            array->buffer,
+            array->capacity * array->size,
+            capacity * array->size,
+            alignof(max_align_t)
+        );
 
-    // If there are more elements than there would be capacity, cannot reduce.
-    if (array->length > (array->capacity >> 1))
-        return;
+        if (!reallocated)
+            return false;
 
-    // Reduce the capacity until we cannot fit the elements. 
-    // @TODO: Do this mathematically.
-    int capacity = array->capacity >> 1;
-    while (capacity > array->length)
-        capacity >>= 1;
+        array->buffer = reallocated;
+        array->capacity = capacity;
+        return true;
+    }
 
-    size_t *reallocated = realloc(array->buffer, capacity * array->size);
+    // Move back into the inline storage when the elements fit in it.
+    if (array->inline_capacity > 0 && capacity <= array->inline_capacity) {
+        if (!array_is_inline(array)) {
+            void *storage = array_storage(array);
+            memcpy(storage, array->buffer, array->length * array->size);
+            free(array->buffer);
+            array->buffer = storage;
+        }
 
-    // If the reallocation was successful, set the correct values in the array.
-    if (reallocated || array->length == 0) {
-        array->buffer = reallocated;
+        array->capacity = array->inline_capacity;
+        return true;
+    }
+
+    // Spill out of the inline storage onto the heap.
+    if (array_is_inline(array)) {
+        void *buffer = malloc(capacity * array->size);
+        if (!buffer)
+            return false;
+
+        memcpy(buffer, array->buffer, array->length * array->size);
+        array->buffer = buffer;
         array->capacity = capacity;
+        return true;
     }
 
+    if (capacity == 0) {
+        free(array->buffer);
+        array->buffer = NULL;
+        array->capacity = 0;
+        return true;
+    }
+
+    void *reallocated = realloc(array->buffer, capacity * array->size);
+    if (!reallocated)
+        return false;
+
+    array->buffer = reallocated;
+    array->capacity = capacity;
+
+    return true;
+}
+
+void array_reduce(Array *array)
+{
+    // Check if we can free memory. Occurs when the array is less than a
+    // quarter full, rather than half, so that pushing and popping around a
+    // power of 2 does not reallocate every time. Arena memory is only freed by
+    // resetting the arena, and inline storage is never freed.
+    if (array->arena || array_is_inline(array))
+        return;
+
+    if (array->capacity <= 1 || array->length > (array->capacity >> 2))
+        return;
+
+    // Halve the capacity until the array is more than a quarter full, leaving
+    // room to grow before the next reallocation. Clearing the array frees the
+    // buffer entirely.
+    int capacity = array->capacity >> 1;
+    while (capacity > 1 && (capacity >> 2) >= array->length)
+        capacity >>= 1;
+
     // If the reallocation was unsuccessful, ignore and attempt to reduce on
     // next time.
-    return;
+    array_reallocate(array, capacity);
 }
 
 bool array_allocate(Array *array, int n)
@@ -84,18 +218,29 @@ bool array_allocate(Array *array, int n)
     while (capacity < array->length + n)
         capacity <<= 1;
 
-    size_t *reallocated = realloc(
-        array->buffer,
-        capacity * array->size
-    );
+    return array_reallocate(array, capacity);
+}
 
-    if (!reallocated)
+bool array_reserve(Array *array, int capacity)
+{
+    if (!array || capacity < 0)
         return false;
 
-    array->buffer = reallocated;
-    array->capacity = capacity;
+    if (capacity <= array->capacity)
+        return true;
 
-    return true;
+    return array_reallocate(array, capacity);
+}
+
+bool array_shrink_to_fit(Array *array)
+{
+    if (!array)
+        return false;
+
+    if (array->arena || array->length == array->capacity)
+        return true;
+
+    return array_reallocate(array, array->length);
 }
 
 bool array_at_pointer(Array *array, int index, void **element)
@@ -160,6 +305,20 @@ int array_length(Array *array)
     return array->length;
 }
 
+bool array_resize(Array *array, int length)
+{
+    if (!array || length < 0)
+        return false;
+
+    // Only allocate when growing, never free.
+    int grow = length - array->length;
+    if (grow > 0 && !array_allocate(array, grow))
+        return false;
+
+    array->length = length;
+    return true;
+}
+
 bool array_insert(Array *array, int index, void *element)
 {
     // Ensure the array and element is not null, and that there is allocated
@@ -176,9 +335,11 @@ bool array_insert(Array *array, int index, void *element)
     // Shift the buffer to the right by one element at the position of 
     // insertion.
     uint8_t *buf = array->buffer;
-    for (int i = array->length * array->size; i-- > index * array->size;) {
-        buf[i + array->size] = buf[i];
-    }
+    memmove(
+        buf + (index + 1) * array->size,
+        buf + index * array->size,
+        (array->length - index) * array->size
+    );
 
     // Copy the element into the insertion place.
     memcpy(
@@ -209,6 +370,25 @@ bool array_push_back(Array *array, void *element)
     return true;
 }
 
+bool array_append_n(Array *array, const void *elements, int n)
+{
+    if (!array || n < 0 || (n > 0 && !elements) || !array_allocate(array, n))
+        return false;
+
+    if (n == 0)
+        return true;
+
+    // Copy all of the elements onto the end at once.
+    memcpy(
+        (uint8_t*)array->buffer + array->size * array->length,
+        elements,
+        array->size * n
+    );
+
+    array->length += n;
+    return true;
+}
+
 bool array_pop_back(Array *array, void *element)
 {
     // Ensure the array is not NULL and there exists an element to pop.
@@ -236,13 +416,14 @@ bool array_erase(Array *array, int index)
         return false;
 
     uint8_t *buf = array->buffer;
-    int end = (array->length - 1) * array->size;
 
     // Shift the buffer one element to the left at the index, overwriting it's
     // data.
-    for (int i = index * array->size; i < end; i++) {
-        buf[i] = buf[i + array->size];
-    }
+    memmove(
+        buf + index * array->size,
+        buf + (index + 1) * array->size,
+        (array->length - index - 1) * array->size
+    );
 
     array->length--;
     array_reduce(array);
@@ -265,14 +446,14 @@ bool array_erase_range(Array *array, int index_from, int index_to)
     int n = (index_to - index_from);
 
     uint8_t *buf = array->buffer;
-    int end = (array->length - n) * array->size;
-    int offset = n * array->size;
 
     // Shift the buffer to the left by n elements and overwrite the range
     // of values.
-    for (int i = index_from * array->size; i < end; i++) {
-        buf[i] = buf[i + offset];
-    }
+    memmove(
+        buf + index_from * array->size,
+        buf + index_to * array->size,
+        (array->length - index_to) * array->size
+    );
 
     array->length -= n;
     array_reduce(array);
@@ -280,6 +461,28 @@ bool array_erase_range(Array *array, int index_from, int index_to)
     return true;
 }
 
+bool array_erase_unordered(Array *array, int index)
+{
+    // Ensure the array is not NULL and the index is in range.
+    if (!array || index < 0 || index >= array->length)
+        return false;
+
+    // Move the last element into the erased element's place.
+    int last = array->length - 1;
+    if (index != last) {
+        memcpy(
+            (uint8_t*)array->buffer + array->size * index,
+            (uint8_t*)array->buffer + array->size * last,
+            array->size
+        );
+    }
+
+    array->length--;
+    array_reduce(array);
+
+    return true;
+}
+
 void array_apply(Array *array, ArrayApplyFunction func, void *data)
 {
     for (int i = 0; i < array->length; i++) {
@@ -289,15 +492,23 @@ void array_apply(Array *array, ArrayApplyFunction func, void *data)
 
 void array_clear(Array *array)
 {
-    free(array->buffer);
+    if (!array->arena && !array_is_inline(array))
+        free(array->buffer);
 
-    array->buffer = NULL;
+    // Fall back to the inline storage if there is any.
+    array->buffer = array->inline_capacity ? array_storage(array) : NULL;
     array->length = 0;
-    array->capacity = 0;
+    array->capacity = array->inline_capacity;
 }
 
 void array_destroy(Array *array)
 {
-    free(array->buffer);
+    // Arrays in an arena are freed with the arena.
+    if (!array || array->arena)
+        return;
+
+    if (!array_is_inline(array))
+        free(array->buffer);
+
     free(array);
 }
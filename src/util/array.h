@@ -5,11 +5,18 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include "util/arena.h"
+
 typedef struct {
     void *buffer;
     size_t size;
     size_t length;
     size_t capacity;
+    // The number of elements that fit in storage allocated together with the
+    // array, or 0 if there is none.
+    size_t inline_capacity;
+    // The arena the array is allocated from, or NULL if on the heap.
+    Arena *arena;
  } Array;
 
 /**
@@ -20,6 +27,31 @@ typedef struct {
  */
 Array *array_create(size_t size);
 
+/**
+ * Create a new variably sized array with storage for a number of elements
+ * allocated together with the array. Elements are kept in the inline storage
+ * until there are more than fit, when they spill onto the heap, and move back
+ * once they fit again. Suits arrays that are usually short, costing one
+ * allocation and keeping the elements next to the array.
+ * 
+ * @param size The element size of the array.
+ * @param n The number of elements that fit in the inline storage.
+ * @returns Pointer to the array on success, or NULL on failure.
+ */
+Array *array_create_inline(size_t size, int n);
+
+/**
+ * Create a new variably sized array in an arena. The array and its elements
+ * are allocated from the arena, and are freed when the arena is reset rather
+ * than by destroying the array. The array must not be used after the arena is
+ * reset.
+ * 
+ * @param arena The arena to allocate the array from.
+ * @param size The element size of the array.
+ * @returns Pointer to the array on success, or NULL on failure.
+ */
+Array *array_create_arena(Arena *arena, size_t size);
+
 /**
  * Create an array from another array by copying.
  * 
@@ -33,8 +65,8 @@ Array *array_create_from_array(Array *array);
  * elements are known to be added to reduce system memory allocation
  * calls.
  * 
- * Preallocated memory will be freed if not used on the next call to remove an
- * element from the array.
+ * Preallocated memory will be freed if the array is less than a quarter full
+ * on the next call to remove an element from the array.
  * 
  * @param array The array to allocate memory for.
  * @param n The number of elements to be added to the array to preallocate.
@@ -44,6 +76,27 @@ Array *array_create_from_array(Array *array);
  */
 bool array_allocate(Array *array, int n);
 
+/**
+ * Grow the capacity of the array to exactly the provided number of elements,
+ * if it is not already at least that large. Does not free memory.
+ * 
+ * @param array The array to reserve memory for.
+ * @param capacity The number of elements to have capacity for.
+ * 
+ * @returns True on success, false on failure to allocate memory.
+ */
+bool array_reserve(Array *array, int capacity);
+
+/**
+ * Free the unused capacity of the array, such that its capacity is its
+ * length. Does nothing for arrays in an arena.
+ * 
+ * @param array The array to shrink.
+ * 
+ * @returns True on success, false on failure to reallocate memory.
+ */
+bool array_shrink_to_fit(Array *array);
+
 /**
  * Get a pointer to an element from the array at the provided index, and assign
  * it to the provided element pointer.
@@ -139,6 +192,18 @@ int array_length(Array *array);
  */
 void array_clear(Array *array);
 
+/**
+ * Set the length of the array without freeing memory. Elements added by
+ * growing the array are uninitialised. Useful for reusing an array's buffer
+ * between uses without reallocating it.
+ * 
+ * @param array The array to resize.
+ * @param length The new length of the array.
+ * 
+ * @returns True on success, false on failure to allocate memory.
+ */
+bool array_resize(Array *array, int length);
+
 /**
  * Insert an element into the array at the provided index.
  * 
@@ -160,6 +225,18 @@ bool array_insert(Array *array, int index, void *element);
  */
 bool array_push_back(Array *array, void *element);
 
+/**
+ * Append a number of elements to the end / back of the array, allocating at
+ * most once.
+ * 
+ * @param array The array to add the elements to.
+ * @param elements Pointer to the first of the contiguous elements to append.
+ * @param n The number of elements to append.
+ * 
+ * @returns True on success, false on failure.
+ */
+bool array_append_n(Array *array, const void *elements, int n);
+
 /**
  * Copy the last element into the provided element, and then remove it from
  * the array.
@@ -193,6 +270,18 @@ bool array_erase(Array *array, int index);
  */
 bool array_erase_range(Array *array, int index_from, int index_to);
 
+/**
+ * Erase an element from the array at the provided index by moving the last
+ * element into its place. Does not preserve the order of the elements, but
+ * does not shift the rest of the array.
+ * 
+ * @param array The array to erase to element from.
+ * @param index The index of the element in the array to erase.
+ * 
+ * @returns True on success, false on failure.
+ */
+bool array_erase_unordered(Array *array, int index);
+
 /**
  * Function prototype to provide to array_apply.
  * 
@@ -1,6 +1,10 @@
 #ifndef DEFINITIONS_H
 #define DEFINITIONS_H
 
+#include <stdbool.h>
+
+#include "util/time.h"
+
 /**
  * Generic direction definition in 3D space along the NORTH-EAST, 
  * SOUTH-WEST and IN-OUT axes.
@@ -15,4 +19,38 @@ typedef enum {
     DIRECTION_OUT
 } Direction;
 
+/**
+ * The actions the controller instructs the model and view to perform.
+ */
+typedef enum {
+    // Start or stop moving the view in a direction.
+    COMMAND_VIEW_MOVE,
+    // Resize the view to a new window size.
+    COMMAND_VIEW_RESIZE,
+    // Pause or resume the model.
+    COMMAND_MODEL_PAUSE_TOGGLE
+} CommandType;
+
+/**
+ * An action from the controller, queued for the model or view to perform at
+ * the start of its next tick.
+ */
+typedef struct {
+    CommandType type;
+    // The global time the command was issued.
+    Time time;
+    union {
+        // The direction to move in, and whether to start or stop moving.
+        struct {
+            Direction direction;
+            bool state;
+        } move;
+        // The new width and height of the window.
+        struct {
+            int x;
+            int y;
+        } resize;
+    };
+} Command;
+
 #endif // DEFINITIONS_H
\ No newline at end of file
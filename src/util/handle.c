@@ -0,0 +1,162 @@
+#include "util/handle.h"
+
+#include "util/array.h"
+#include "util/typed_array.h"
+
+// The mask of a handle's slot index.
+#define HANDLE_INDEX_MASK ((uint32_t)HANDLE_MAX_SLOTS - 1)
+
+// The number of distinct generations of a slot.
+#define HANDLE_GENERATIONS (1u << (32 - HANDLE_INDEX_BITS))
+
+/**
+ * A slot of a handle table.
+ */
+typedef struct {
+    // The generation of the slot, incremented whenever its element is
+    // removed. Never 0, so that no handle is ever HANDLE_NULL.
+    uint32_t generation;
+    // The index of the slot's element, or the next free slot if the slot is
+    // free, -1 terminating the free list.
+    int index;
+} HandleSlot;
+
+ARRAY_DEFINE(handle_slot_array, HandleSlot)
+ARRAY_DEFINE(handle_array, Handle)
+
+struct HandleTable {
+    // The slots, indexed by the slot index of a handle.
+    Array *slots;
+    // The handle of each element, indexed by element.
+    Array *handles;
+    // The first free slot, or -1 if every slot is in use.
+    int free;
+};
+
+HandleTable *handle_table_create()
+{
+    HandleTable *table = malloc(sizeof(HandleTable));
+    if (!table)
+        return NULL;
+
+    table->slots = handle_slot_array_create();
+    table->handles = handle_array_create();
+    table->free = -1;
+
+    if (!table->slots || !table->handles) {
+        handle_table_destroy(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+static inline Handle handle_make(int slot, uint32_t generation)
+{
+    return (generation << HANDLE_INDEX_BITS) | (uint32_t)slot;
+}
+
+Handle handle_table_push(HandleTable *table)
+{
+    int index = handle_array_length(table->handles);
+
+    // Reuse a free slot, or add a new slot if there are none.
+    int slot = table->free;
+    if (slot < 0) {
+        slot = handle_slot_array_length(table->slots);
+        if (slot >= HANDLE_MAX_SLOTS)
+            return HANDLE_NULL;
+
+        if (!handle_slot_array_push_back(table->slots, (HandleSlot){1, -1}))
+            return HANDLE_NULL;
+    }
+
+    HandleSlot *entry = handle_slot_array_get(table->slots, slot);
+    Handle handle = handle_make(slot, entry->generation);
+
+    if (!handle_array_push_back(table->handles, handle)) {
+        if (slot != table->free)
+            handle_slot_array_resize(table->slots, slot);
+        return HANDLE_NULL;
+    }
+
+    if (slot == table->free)
+        table->free = entry->index;
+
+    entry->index = index;
+    return handle;
+}
+
+bool handle_table_reserve(HandleTable *table, int capacity)
+{
+    return handle_slot_array_reserve(table->slots, capacity)
+        && handle_array_reserve(table->handles, capacity);
+}
+
+bool handle_table_swap_remove(HandleTable *table, int index)
+{
+    int n = handle_array_length(table->handles);
+    if (index < 0 || index >= n)
+        return false;
+
+    Handle removed = *handle_array_get(table->handles, index);
+    Handle moved = *handle_array_get(table->handles, n - 1);
+
+    // Point the moved element's slot at its new index. Resize rather than
+    // erase, which would shrink the buffer, so that elements coming and going
+    // does not touch the heap.
+    int moved_slot = moved & HANDLE_INDEX_MASK;
+    handle_slot_array_get(table->slots, moved_slot)->index = index;
+    *handle_array_get(table->handles, index) = moved;
+    handle_array_resize(table->handles, n - 1);
+
+    // Make the removed handle stale, skipping generation 0, and free its
+    // slot.
+    int slot = removed & HANDLE_INDEX_MASK;
+    HandleSlot *entry = handle_slot_array_get(table->slots, slot);
+    entry->generation = (entry->generation + 1) % HANDLE_GENERATIONS;
+    if (entry->generation == 0)
+        entry->generation = 1;
+
+    entry->index = table->free;
+    table->free = slot;
+
+    return true;
+}
+
+int handle_table_index(HandleTable *table, Handle handle)
+{
+    int slot = handle & HANDLE_INDEX_MASK;
+    if (handle == HANDLE_NULL || slot >= handle_slot_array_length(table->slots))
+        return -1;
+
+    HandleSlot *entry = handle_slot_array_get(table->slots, slot);
+    if (handle_make(slot, entry->generation) != handle)
+        return -1;
+
+    return entry->index;
+}
+
+Handle handle_table_handle(HandleTable *table, int index)
+{
+    Handle handle;
+    if (!handle_array_at_copy(table->handles, index, &handle))
+        return HANDLE_NULL;
+
+    return handle;
+}
+
+int handle_table_length(HandleTable *table)
+{
+    return handle_array_length(table->handles);
+}
+
+void handle_table_destroy(HandleTable *table)
+{
+    if (!table)
+        return;
+
+    array_destroy(table->slots);
+    array_destroy(table->handles);
+    free(table);
+}
@@ -0,0 +1,126 @@
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The number of bits of a handle that index its slot in a handle table. The
+// remaining bits hold the slot's generation.
+#define HANDLE_INDEX_BITS 20
+
+// The most handles a table can hold at once.
+#define HANDLE_MAX_SLOTS (1 << HANDLE_INDEX_BITS)
+
+// A handle that never refers to anything.
+#define HANDLE_NULL 0
+
+/**
+ * A stable reference to an element of a dense store that moves its elements
+ * around, such as by swap removing. The low HANDLE_INDEX_BITS bits select a
+ * slot of a HandleTable, which holds the element's current index, and the
+ * high bits hold the generation of the slot when the handle was made. A slot's
+ * generation changes whenever its element is removed, so stale handles are
+ * detected rather than referring to whichever element reused the slot.
+ */
+typedef uint32_t Handle;
+
+/**
+ * Pack an unordered pair of handles into a single key, for use with HashMap.
+ * 
+ * @param a The first handle.
+ * @param b The second handle.
+ * 
+ * @returns The key, the same for either order of the handles.
+ */
+static inline uint64_t handle_pair_key(Handle a, Handle b)
+{
+    return a < b
+        ? ((uint64_t)a << 32) | b
+        : ((uint64_t)b << 32) | a;
+}
+
+/**
+ * The indirection between handles and the indicies of elements in a dense
+ * store. The table is kept parallel to the store: push a handle whenever an
+ * element is appended to the store, and swap remove whenever one is swap
+ * removed from it. Looking up a handle is two array reads.
+ */
+typedef struct HandleTable HandleTable;
+
+/**
+ * Create a new empty handle table.
+ * 
+ * @returns Pointer to the table, or NULL on failure.
+ */
+HandleTable *handle_table_create();
+
+/**
+ * Make a handle for a new element appended to the end of the store.
+ * 
+ * @param table The table.
+ * 
+ * @returns The handle of the element, or HANDLE_NULL on failure to allocate
+ * or if the table is full.
+ */
+Handle handle_table_push(HandleTable *table);
+
+/**
+ * Grow the table until it has capacity for a number of elements, such that
+ * that many handles can be pushed without touching the heap. Removing never
+ * gives the capacity back.
+ * 
+ * @param table The table.
+ * @param capacity The number of elements to have capacity for.
+ * 
+ * @returns True on success, false on failure to allocate.
+ */
+bool handle_table_reserve(HandleTable *table, int capacity);
+
+/**
+ * Remove an element by moving the last element into its index, as the store
+ * does. The removed element's handle becomes stale, and the moved element's
+ * handle now looks up its new index.
+ * 
+ * @param table The table.
+ * @param index The index of the element to remove.
+ * 
+ * @returns True on success, false if the index is out of range.
+ */
+bool handle_table_swap_remove(HandleTable *table, int index);
+
+/**
+ * Look up the current index of the element a handle refers to.
+ * 
+ * @param table The table.
+ * @param handle The handle.
+ * 
+ * @returns The index of the element, or -1 if the handle is stale or null.
+ */
+int handle_table_index(HandleTable *table, Handle handle);
+
+/**
+ * Get the handle of the element at an index.
+ * 
+ * @param table The table.
+ * @param index The index of the element.
+ * 
+ * @returns The handle of the element, or HANDLE_NULL if out of range.
+ */
+Handle handle_table_handle(HandleTable *table, int index);
+
+/**
+ * Get the number of elements with handles.
+ * 
+ * @param table The table.
+ * @returns The number of elements.
+ */
+int handle_table_length(HandleTable *table);
+
+/**
+ * Deallocate a handle table. Using the table after this call is undefined.
+ * 
+ * @param table The table to destroy.
+ */
+void handle_table_destroy(HandleTable *table);
+
+#endif // HANDLE_H
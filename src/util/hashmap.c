@@ -0,0 +1,235 @@
+#include "util/hashmap.h"
+
+#include <string.h>
+
+struct HashMap {
+    // The key in each slot.
+    uint64_t *keys;
+    // Whether each slot is occupied.
+    uint8_t *used;
+    // The value in each slot, of size bytes each.
+    uint8_t *values;
+    // The size of each value.
+    size_t size;
+    // The number of occupied slots.
+    int length;
+    // The number of slots. Always zero or a power of 2.
+    int capacity;
+};
+
+HashMap *hashmap_create(size_t size)
+{
+    HashMap *map = malloc(sizeof(HashMap));
+    if (!map)
+        return NULL;
+
+    map->keys = NULL;
+    map->used = NULL;
+    map->values = NULL;
+    map->size = size;
+    map->length = 0;
+    map->capacity = 0;
+
+    return map;
+}
+
+static inline int hashmap_slot(HashMap *map, uint64_t key)
+{
+    // Mix the bits of the key so that keys differing only in their high or
+    // low bits do not cluster (splitmix64 finaliser).
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key & (map->capacity - 1);
+}
+
+static bool hashmap_grow(HashMap *map)
+{
+    int capacity = map->capacity ? map->capacity << 1 : 16;
+
+    uint64_t *keys = malloc(capacity * sizeof(uint64_t));
+    uint8_t *used = calloc(capacity, 1);
+    uint8_t *values = map->size ? malloc(capacity * map->size) : NULL;
+
+    if (!keys || !used || (map->size && !values)) {
+        free(keys);
+        free(used);
+        free(values);
+        return false;
+    }
+
+    // Swap in the new slots and reinsert every key from the old slots.
+    uint64_t *old_keys = map->keys;
+    uint8_t *old_used = map->used;
+    uint8_t *old_values = map->values;
+    int old_capacity = map->capacity;
+
+    map->keys = keys;
+    map->used = used;
+    map->values = values;
+    map->capacity = capacity;
+
+    for (int i = 0; i < old_capacity; i++) {
+        if (!old_used[i])
+            continue;
+
+        int slot = hashmap_slot(map, old_keys[i]);
+        while (used[slot])
+            slot = (slot + 1) & (capacity - 1);
+
+        keys[slot] = old_keys[i];
+        used[slot] = 1;
+        if (map->size)
+            memcpy(
+                values + slot * map->size,
+                old_values + i * map->size,
+                map->size
+            );
+    }
+
+    free(old_keys);
+    free(old_used);
+    free(old_values);
+
+    return true;
+}
+
+static int hashmap_locate(HashMap *map, uint64_t key)
+{
+    if (map->capacity == 0)
+        return -1;
+
+    // Linear probe until the key or an empty slot is found.
+    int slot = hashmap_slot(map, key);
+    while (map->used[slot]) {
+        if (map->keys[slot] == key)
+            return slot;
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+
+    return -1;
+}
+
+void *hashmap_insert(HashMap *map, uint64_t key, void *value)
+{
+    int slot = hashmap_locate(map, key);
+
+    if (slot < 0) {
+
+        // Keep the load factor at or below 1/2 so that probes stay short.
+        if (2 * (map->length + 1) > map->capacity && !hashmap_grow(map))
+            return NULL;
+
+        slot = hashmap_slot(map, key);
+        while (map->used[slot])
+            slot = (slot + 1) & (map->capacity - 1);
+
+        map->keys[slot] = key;
+        map->used[slot] = 1;
+        map->length++;
+
+        if (!value && map->size)
+            memset(map->values + slot * map->size, 0, map->size);
+    }
+
+    if (value && map->size)
+        memcpy(map->values + slot * map->size, value, map->size);
+
+    // Sets have no values, but success must still be distinguishable.
+    return map->size ? (void*)(map->values + slot * map->size) : (void*)map;
+}
+
+void *hashmap_find(HashMap *map, uint64_t key)
+{
+    int slot = hashmap_locate(map, key);
+    if (slot < 0 || !map->size)
+        return NULL;
+
+    return map->values + slot * map->size;
+}
+
+bool hashmap_contains(HashMap *map, uint64_t key)
+{
+    return hashmap_locate(map, key) >= 0;
+}
+
+bool hashmap_erase(HashMap *map, uint64_t key)
+{
+    int slot = hashmap_locate(map, key);
+    if (slot < 0)
+        return false;
+
+    // Shift back any following keys in the same probe run that would no
+    // longer be reachable across the emptied slot, rather than leaving a
+    // tombstone.
+    int mask = map->capacity - 1;
+    int empty = slot;
+    int next = (slot + 1) & mask;
+
+    while (map->used[next]) {
+        int home = hashmap_slot(map, map->keys[next]);
+
+        // The key can move into the empty slot if its home slot is not
+        // cyclically between the empty slot (exclusive) and itself.
+        if (((next - home) & mask) >= ((next - empty) & mask)) {
+            map->keys[empty] = map->keys[next];
+            if (map->size)
+                memcpy(
+                    map->values + empty * map->size,
+                    map->values + next * map->size,
+                    map->size
+                );
+            empty = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    map->used[empty] = 0;
+    map->length--;
+
+    return true;
+}
+
+bool hashmap_next(HashMap *map, int *iterator, uint64_t *key, void **value)
+{
+    while (*iterator < map->capacity) {
+        int slot = (*iterator)++;
+        if (!map->used[slot])
+            continue;
+
+        if (key)
+            *key = map->keys[slot];
+        if (value)
+            *value = map->size ? map->values + slot * map->size : NULL;
+
+        return true;
+    }
+
+    return false;
+}
+
+int hashmap_length(HashMap *map)
+{
+    return map->length;
+}
+
+void hashmap_clear(HashMap *map)
+{
+    if (map->capacity)
+        memset(map->used, 0, map->capacity);
+    map->length = 0;
+}
+
+void hashmap_destroy(HashMap *map)
+{
+    if (!map)
+        return;
+
+    free(map->keys);
+    free(map->used);
+    free(map->values);
+    free(map);
+}
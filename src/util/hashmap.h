@@ -0,0 +1,105 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * An open addressing hash map from 64 bit integer keys to fixed size values.
+ * 
+ * Values are copied into the map like elements into an Array. A map with a
+ * value size of zero is a set of keys.
+ */
+typedef struct HashMap HashMap;
+
+/**
+ * Create a new hash map.
+ * 
+ * @param size The size of the values in the map. May be zero for a set.
+ * @returns Pointer to the hash map on success, or NULL on failure.
+ */
+HashMap *hashmap_create(size_t size);
+
+/**
+ * Insert a key into the map, or overwrite its value if it is already present.
+ * 
+ * @param map The map to insert into.
+ * @param key The key to insert.
+ * @param value Pointer to the value to copy into the map. If NULL, the value
+ * of a new key is zeroed and the value of an existing key is left unchanged.
+ * 
+ * @returns Pointer to the value in the map on success, or NULL on failure to
+ * allocate memory. The pointer is valid until the map is next modified.
+ */
+void *hashmap_insert(HashMap *map, uint64_t key, void *value);
+
+/**
+ * Find the value of a key in the map.
+ * 
+ * @param map The map to search.
+ * @param key The key to find.
+ * 
+ * @returns Pointer to the value in the map, or NULL if the key is not present
+ * or the map is a set. The pointer is valid until the map is next modified.
+ */
+void *hashmap_find(HashMap *map, uint64_t key);
+
+/**
+ * Check if a key is present in the map.
+ * 
+ * @param map The map to search.
+ * @param key The key to find.
+ * 
+ * @returns True if the key is in the map, otherwise false.
+ */
+bool hashmap_contains(HashMap *map, uint64_t key);
+
+/**
+ * Erase a key and its value from the map.
+ * 
+ * @param map The map to erase from.
+ * @param key The key to erase.
+ * 
+ * @returns True if the key was erased, false if it was not present.
+ */
+bool hashmap_erase(HashMap *map, uint64_t key);
+
+/**
+ * Get the next key and value in the map. Iteration order is unspecified, and
+ * modifying the map during iteration is undefined.
+ * 
+ * @param map The map to iterate.
+ * @param iterator Pointer to the iteration position, which must be initialised
+ * to 0 before the first call.
+ * @param key Pointer to set to the next key. Ignored if NULL.
+ * @param value Pointer to set to point to the next value. Ignored if NULL.
+ * 
+ * @returns True if there was a next key, false at the end of the map.
+ */
+bool hashmap_next(HashMap *map, int *iterator, uint64_t *key, void **value);
+
+/**
+ * Return the number of keys in the map.
+ * 
+ * @param map The map to check the length of.
+ * @returns The number of keys in the map.
+ */
+int hashmap_length(HashMap *map);
+
+/**
+ * Remove all keys from the map without freeing memory.
+ * 
+ * @param map The map to clear.
+ */
+void hashmap_clear(HashMap *map);
+
+/**
+ * Deallocate and destroy the provided map. Using the map after this call is
+ * undefined.
+ * 
+ * @param map The map to destroy.
+ */
+void hashmap_destroy(HashMap *map);
+
+#endif // HASHMAP_H
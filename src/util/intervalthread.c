@@ -19,6 +19,9 @@ struct IntervalThread {
     // Timer to notify the condition variable to call the thread function 
     // every interval.
     SDL_TimerID timer;
+    // The number of milliseconds between each call, read by the timer to
+    // reschedule itself.
+    SDL_atomic_t interval;
     // Boolean to quit the thread with on destruction.
     bool done;
     // Optional name for the thread.
@@ -33,7 +36,8 @@ uint32_t interval_thread_timer_callback(uint32_t interval, void *data)
     // function.
     SDL_CondBroadcast(thread->condition);
 
-    return interval;
+    // Returning a new interval reschedules the timer with it.
+    return SDL_AtomicGet(&thread->interval);
 }
 
 int interval_thread_wrapper(void *data)
@@ -77,6 +81,7 @@ IntervalThread *interval_thread_create(
     thread->condition = SDL_CreateCond();
     thread->data = data;
     thread->func = func;
+    SDL_AtomicSet(&thread->interval, interval);
     thread->timer = SDL_AddTimer(interval, interval_thread_timer_callback, thread);
     thread->done = false;
 
@@ -92,6 +97,11 @@ IntervalThread *interval_thread_create(
     return thread;
 }
 
+void interval_thread_set_interval(IntervalThread *thread, uint32_t interval)
+{
+    SDL_AtomicSet(&thread->interval, interval);
+}
+
 void interval_thread_destroy(IntervalThread *thread)
 {
     if (!thread)
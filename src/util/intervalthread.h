@@ -26,6 +26,14 @@ IntervalThread *interval_thread_create(
     const char *name
 );
 
+/**
+ * @brief Change the number of milliseconds between each function call. Takes
+ * effect after the next call.
+ * @param thread The interval thread.
+ * @param interval The new number of milliseconds between each function call.
+ */
+void interval_thread_set_interval(IntervalThread *thread, uint32_t interval);
+
 /**
  * @brief Waits for the current function execution to return before destroying
  * the interval thread and deallocating it's memory.
@@ -0,0 +1,209 @@
+#include "util/intrusive_list.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct IntrusiveList {
+    // The links of the list are a ring through this sentinel, whose next is
+    // the front and last is the back, so linking never has to check for the
+    // ends of the list.
+    ListLink sentinel;
+    // The size of an element, and the offset of its link within it.
+    size_t size;
+    size_t offset;
+    // The pool the elements are allocated from.
+    Pool *pool;
+    int length;
+};
+
+IntrusiveList *intrusive_list_create(size_t size, size_t offset, int chunk)
+{
+    if (offset + sizeof(ListLink) > size)
+        return NULL;
+
+    IntrusiveList *list = malloc(sizeof(IntrusiveList));
+    if (!list)
+        return NULL;
+
+    list->pool = pool_create(size, chunk);
+    if (!list->pool) {
+        free(list);
+        return NULL;
+    }
+
+    list->sentinel.next = &list->sentinel;
+    list->sentinel.last = &list->sentinel;
+    list->size = size;
+    list->offset = offset;
+    list->length = 0;
+
+    return list;
+}
+
+/**
+ * Get the link embedded in an element.
+ */
+static inline ListLink *intrusive_list_link(IntrusiveList *list, void *element)
+{
+    return (ListLink*)((uint8_t*)element + list->offset);
+}
+
+/**
+ * Get the element a link is embedded in, or NULL for the sentinel.
+ */
+static inline void *intrusive_list_element(IntrusiveList *list, ListLink *link)
+{
+    if (link == &list->sentinel)
+        return NULL;
+
+    return (uint8_t*)link - list->offset;
+}
+
+/**
+ * Link a link in between two adjacent links.
+ */
+static inline void intrusive_list_splice(
+    ListLink *link,
+    ListLink *last,
+    ListLink *next
+) {
+    link->last = last;
+    link->next = next;
+    last->next = link;
+    next->last = link;
+}
+
+/**
+ * Unlink a link from its neighbours.
+ */
+static inline void intrusive_list_unlink(ListLink *link)
+{
+    link->last->next = link->next;
+    link->next->last = link->last;
+}
+
+void *intrusive_list_insert_after(IntrusiveList *list, void *element)
+{
+    ListLink *last = element
+        ? intrusive_list_link(list, element)
+        : &list->sentinel;
+
+    void *new = pool_allocate(list->pool);
+    if (!new)
+        return NULL;
+
+    intrusive_list_splice(intrusive_list_link(list, new), last, last->next);
+    list->length++;
+
+    return new;
+}
+
+void *intrusive_list_push_front(IntrusiveList *list)
+{
+    return intrusive_list_insert_after(list, NULL);
+}
+
+void *intrusive_list_push_back(IntrusiveList *list)
+{
+    return intrusive_list_insert_after(list, intrusive_list_back(list));
+}
+
+void intrusive_list_remove(IntrusiveList *list, void *element)
+{
+    if (!element)
+        return;
+
+    intrusive_list_unlink(intrusive_list_link(list, element));
+    pool_free(list->pool, element);
+    list->length--;
+}
+
+void intrusive_list_move_front(IntrusiveList *list, void *element)
+{
+    ListLink *link = intrusive_list_link(list, element);
+    intrusive_list_unlink(link);
+    intrusive_list_splice(link, &list->sentinel, list->sentinel.next);
+}
+
+void intrusive_list_move_back(IntrusiveList *list, void *element)
+{
+    ListLink *link = intrusive_list_link(list, element);
+    intrusive_list_unlink(link);
+    intrusive_list_splice(link, list->sentinel.last, &list->sentinel);
+}
+
+/**
+ * Copy an element into the provided element, if any, and remove it.
+ */
+static bool intrusive_list_pop(
+    IntrusiveList *list,
+    void *popped,
+    void *element
+) {
+    if (!popped)
+        return false;
+
+    if (element)
+        memcpy(element, popped, list->size);
+
+    intrusive_list_remove(list, popped);
+    return true;
+}
+
+bool intrusive_list_pop_front(IntrusiveList *list, void *element)
+{
+    return intrusive_list_pop(list, intrusive_list_front(list), element);
+}
+
+bool intrusive_list_pop_back(IntrusiveList *list, void *element)
+{
+    return intrusive_list_pop(list, intrusive_list_back(list), element);
+}
+
+void *intrusive_list_front(IntrusiveList *list)
+{
+    return intrusive_list_element(list, list->sentinel.next);
+}
+
+void *intrusive_list_back(IntrusiveList *list)
+{
+    return intrusive_list_element(list, list->sentinel.last);
+}
+
+void *intrusive_list_next(IntrusiveList *list, void *element)
+{
+    return intrusive_list_element(
+        list,
+        intrusive_list_link(list, element)->next
+    );
+}
+
+void *intrusive_list_previous(IntrusiveList *list, void *element)
+{
+    return intrusive_list_element(
+        list,
+        intrusive_list_link(list, element)->last
+    );
+}
+
+int intrusive_list_length(IntrusiveList *list)
+{
+    return list->length;
+}
+
+void intrusive_list_clear(IntrusiveList *list)
+{
+    while (list->length > 0)
+        intrusive_list_remove(list, intrusive_list_front(list));
+}
+
+void intrusive_list_destroy(IntrusiveList *list)
+{
+    if (!list)
+        return;
+
+    // The elements are freed with the pool.
+    pool_destroy(list->pool);
+    free(list);
+}
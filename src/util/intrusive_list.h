@@ -0,0 +1,194 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "util/pool.h"
+
+// The links of an element in an intrusive list, embedded in the element.
+typedef struct ListLink {
+    struct ListLink *next;
+    struct ListLink *last;
+} ListLink;
+
+/**
+ * A doubly linked list whose links are embedded in its elements, rather than
+ * each element being copied into a separately allocated node as in List.
+ * Elements are allocated from a Pool owned by the list, so pushing costs no
+ * heap allocation once the pool has grown, and an element is found, unlinked
+ * or moved in constant time from a pointer to it, which serves as its handle.
+ * Element pointers stay valid until the element is removed.
+ * 
+ * Suits free lists, queues and least recently used caches:
+ * 
+ *     typedef struct {
+ *         int value;
+ *         ListLink link;
+ *     } Entry;
+ * 
+ *     IntrusiveList *list = intrusive_list_create(
+ *         sizeof(Entry), offsetof(Entry, link), 64
+ *     );
+ *     Entry *entry = intrusive_list_push_back(list);
+ *     entry->value = 1;
+ *     intrusive_list_move_front(list, entry);
+ *     intrusive_list_remove(list, entry);
+ * 
+ * Not thread safe.
+ */
+typedef struct IntrusiveList IntrusiveList;
+
+/**
+ * Create a new empty list.
+ * 
+ * @param size The size of the element type.
+ * @param offset The offset of the ListLink within the element type, from
+ * offsetof().
+ * @param chunk The number of elements the list's pool allocates at once.
+ * 
+ * @returns Pointer to the list, or NULL on failure.
+ */
+IntrusiveList *intrusive_list_create(size_t size, size_t offset, int chunk);
+
+/**
+ * Allocate a new element and link it at the front of the list in constant
+ * time. The element's contents other than its link are uninitialised.
+ * 
+ * @param list The list to push to.
+ * 
+ * @returns Pointer to the new element, or NULL on failure to allocate.
+ */
+void *intrusive_list_push_front(IntrusiveList *list);
+
+/**
+ * Allocate a new element and link it at the back of the list in constant
+ * time. The element's contents other than its link are uninitialised.
+ * 
+ * @param list The list to push to.
+ * 
+ * @returns Pointer to the new element, or NULL on failure to allocate.
+ */
+void *intrusive_list_push_back(IntrusiveList *list);
+
+/**
+ * Allocate a new element and link it after an element already in the list in
+ * constant time.
+ * 
+ * @param list The list to insert into.
+ * @param element The element to insert after, or NULL to insert at the front.
+ * 
+ * @returns Pointer to the new element, or NULL on failure to allocate.
+ */
+void *intrusive_list_insert_after(IntrusiveList *list, void *element);
+
+/**
+ * Unlink an element from the list and free it in constant time. Using the
+ * element after this call is undefined.
+ * 
+ * @param list The list containing the element.
+ * @param element The element to remove. Does nothing if NULL.
+ */
+void intrusive_list_remove(IntrusiveList *list, void *element);
+
+/**
+ * Move an element already in the list to its front in constant time.
+ * 
+ * @param list The list containing the element.
+ * @param element The element to move.
+ */
+void intrusive_list_move_front(IntrusiveList *list, void *element);
+
+/**
+ * Move an element already in the list to its back in constant time.
+ * 
+ * @param list The list containing the element.
+ * @param element The element to move.
+ */
+void intrusive_list_move_back(IntrusiveList *list, void *element);
+
+/**
+ * Copy the element at the front of the list into the provided element, and
+ * then remove it.
+ * 
+ * @param list The list to pop from.
+ * @param element Pointer to an element to copy the front element into, or
+ * NULL to discard it.
+ * 
+ * @returns False if the list is empty, otherwise true.
+ */
+bool intrusive_list_pop_front(IntrusiveList *list, void *element);
+
+/**
+ * Copy the element at the back of the list into the provided element, and
+ * then remove it.
+ * 
+ * @param list The list to pop from.
+ * @param element Pointer to an element to copy the back element into, or
+ * NULL to discard it.
+ * 
+ * @returns False if the list is empty, otherwise true.
+ */
+bool intrusive_list_pop_back(IntrusiveList *list, void *element);
+
+/**
+ * Get the element at the front of the list.
+ * 
+ * @param list The list.
+ * @returns Pointer to the front element, or NULL if the list is empty.
+ */
+void *intrusive_list_front(IntrusiveList *list);
+
+/**
+ * Get the element at the back of the list.
+ * 
+ * @param list The list.
+ * @returns Pointer to the back element, or NULL if the list is empty.
+ */
+void *intrusive_list_back(IntrusiveList *list);
+
+/**
+ * Get the element after an element in the list, for iterating from front to
+ * back.
+ * 
+ * @param list The list containing the element.
+ * @param element The element.
+ * @returns Pointer to the next element, or NULL if element is the back.
+ */
+void *intrusive_list_next(IntrusiveList *list, void *element);
+
+/**
+ * Get the element before an element in the list, for iterating from back to
+ * front.
+ * 
+ * @param list The list containing the element.
+ * @param element The element.
+ * @returns Pointer to the previous element, or NULL if element is the front.
+ */
+void *intrusive_list_previous(IntrusiveList *list, void *element);
+
+/**
+ * Get the number of elements in the list.
+ * 
+ * @param list The list.
+ * @returns The number of elements.
+ */
+int intrusive_list_length(IntrusiveList *list);
+
+/**
+ * Remove every element from the list, returning them to its pool without
+ * freeing the pool's memory.
+ * 
+ * @param list The list to clear.
+ */
+void intrusive_list_clear(IntrusiveList *list);
+
+/**
+ * Deallocate a list and all of its elements. Using the list or its elements
+ * after this call is undefined.
+ * 
+ * @param list The list to destroy.
+ */
+void intrusive_list_destroy(IntrusiveList *list);
+
+#endif // INTRUSIVE_LIST_H
@@ -0,0 +1,139 @@
+#include "util/pool.h"
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "util/array.h"
+
+struct Pool {
+    // The size of each block, rounded up to hold a free list link and to keep
+    // every block aligned.
+    size_t size;
+    // The number of blocks per chunk.
+    int chunk;
+    // The chunks, an Array of pointers to each chunk.
+    Array *chunks;
+    // The first free block. Each free block holds a pointer to the next.
+    void *free;
+    int length;
+    int capacity;
+    int high_water;
+};
+
+Pool *pool_create(size_t size, int chunk)
+{
+    Pool *pool = malloc(sizeof(Pool));
+    if (!pool)
+        return NULL;
+
+    // Every block must be able to hold the free list link, and be a multiple
+    // of the strictest alignment so that consecutive blocks stay aligned.
+    size_t align = alignof(max_align_t);
+    if (size < sizeof(void*))
+        size = sizeof(void*);
+    size = (size + align - 1) / align * align;
+
+    pool->size = size;
+    pool->chunk = chunk > 0 ? chunk : 1;
+    pool->chunks = array_create(sizeof(void*));
+    pool->free = NULL;
+    pool->length = 0;
+    pool->capacity = 0;
+    pool->high_water = 0;
+
+    if (!pool->chunks) {
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+/**
+ * Allocate a new chunk and push its blocks onto the free list.
+ */
+static bool pool_grow(Pool *pool)
+{
+    uint8_t *chunk = malloc(pool->size * pool->chunk);
+    if (!chunk)
+        return false;
+
+    if (!array_push_back(pool->chunks, &chunk)) {
+        free(chunk);
+        return false;
+    }
+
+    // Push the blocks in reverse so that they are allocated in address order.
+    for (int i = pool->chunk; i-- > 0;) {
+        void *block = chunk + i * pool->size;
+        *(void**)block = pool->free;
+        pool->free = block;
+    }
+
+    pool->capacity += pool->chunk;
+    return true;
+}
+
+void *pool_allocate(Pool *pool)
+{
+    if (!pool->free && !pool_grow(pool))
+        return NULL;
+
+    void *block = pool->free;
+    pool->free = *(void**)block;
+
+    pool->length++;
+    if (pool->length > pool->high_water)
+        pool->high_water = pool->length;
+
+    return block;
+}
+
+void pool_free(Pool *pool, void *block)
+{
+    if (!block)
+        return;
+
+    *(void**)block = pool->free;
+    pool->free = block;
+    pool->length--;
+}
+
+bool pool_reserve(Pool *pool, int capacity)
+{
+    while (pool->capacity < capacity) {
+        if (!pool_grow(pool))
+            return false;
+    }
+
+    return true;
+}
+
+int pool_length(Pool *pool)
+{
+    return pool->length;
+}
+
+int pool_capacity(Pool *pool)
+{
+    return pool->capacity;
+}
+
+int pool_high_water(Pool *pool)
+{
+    return pool->high_water;
+}
+
+void pool_destroy(Pool *pool)
+{
+    if (!pool)
+        return;
+
+    void **chunks = array_data(pool->chunks);
+    for (int i = 0; i < array_length(pool->chunks); i++)
+        free(*(chunks + i));
+
+    array_destroy(pool->chunks);
+    free(pool);
+}
@@ -0,0 +1,91 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * A fixed size block allocator. Blocks are carved from chunks allocated on
+ * the heap, and freed blocks are kept on a free list to be reused, so after
+ * the pool has grown to its peak usage allocating and freeing blocks touches
+ * the heap no more. Chunks are only returned to the heap when the pool is
+ * destroyed.
+ * 
+ * Not thread safe.
+ */
+typedef struct Pool Pool;
+
+/**
+ * Create a new empty pool.
+ * 
+ * @param size The size of each block.
+ * @param chunk The number of blocks to allocate at once when the pool is out
+ * of free blocks.
+ * 
+ * @returns Pointer to the pool, or NULL on failure.
+ */
+Pool *pool_create(size_t size, int chunk);
+
+/**
+ * Allocate a block from the pool. The block is aligned for any type and its
+ * contents are undefined.
+ * 
+ * @param pool The pool.
+ * 
+ * @returns Pointer to the block, or NULL on failure to allocate a new chunk.
+ */
+void *pool_allocate(Pool *pool);
+
+/**
+ * Return a block to the pool. Using the block after this call is undefined.
+ * 
+ * @param pool The pool the block was allocated from.
+ * @param block The block to free. Does nothing if NULL.
+ */
+void pool_free(Pool *pool, void *block);
+
+/**
+ * Grow the pool until it has capacity for a number of blocks, such that that
+ * many blocks can be allocated without touching the heap.
+ * 
+ * @param pool The pool.
+ * @param capacity The number of blocks to have capacity for.
+ * 
+ * @returns True on success, false on failure to allocate.
+ */
+bool pool_reserve(Pool *pool, int capacity);
+
+/**
+ * Get the number of blocks currently allocated from the pool.
+ * 
+ * @param pool The pool.
+ * @returns The number of allocated blocks.
+ */
+int pool_length(Pool *pool);
+
+/**
+ * Get the number of blocks the pool can allocate before growing.
+ * 
+ * @param pool The pool.
+ * @returns The number of allocated and free blocks.
+ */
+int pool_capacity(Pool *pool);
+
+/**
+ * Get the high water mark of the pool, being the most blocks that have been
+ * allocated from it at once.
+ * 
+ * @param pool The pool.
+ * @returns The most blocks allocated at once.
+ */
+int pool_high_water(Pool *pool);
+
+/**
+ * Deallocate a pool and every block allocated from it. Using the pool or its
+ * blocks after this call is undefined.
+ * 
+ * @param pool The pool to destroy.
+ */
+void pool_destroy(Pool *pool);
+
+#endif // POOL_H
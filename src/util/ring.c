@@ -0,0 +1,95 @@
+#include "util/ring.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SDL2/SDL.h"
+
+struct Ring {
+    // The size of each element, and the number of slots in the buffer, being
+    // one more than the capacity so that a full ring is distinguishable from
+    // an empty one.
+    size_t size;
+    int slots;
+    // The slot of the front element, only written by the popping thread, and
+    // the slot after the back element, only written by the pushing thread.
+    SDL_atomic_t head;
+    SDL_atomic_t tail;
+    // The elements.
+    uint8_t *buffer;
+};
+
+Ring *ring_create(size_t size, int capacity)
+{
+    if (size == 0 || capacity <= 0)
+        return NULL;
+
+    // Allocate the ring and its buffer together.
+    int slots = capacity + 1;
+    Ring *ring = malloc(sizeof(Ring) + size * slots);
+    if (!ring)
+        return NULL;
+
+    ring->size = size;
+    ring->slots = slots;
+    ring->buffer = (uint8_t*)(ring + 1);
+    SDL_AtomicSet(&ring->head, 0);
+    SDL_AtomicSet(&ring->tail, 0);
+
+    return ring;
+}
+
+bool ring_push(Ring *ring, const void *element)
+{
+    int tail = SDL_AtomicGet(&ring->tail);
+    int next = (tail + 1) % ring->slots;
+
+    if (next == SDL_AtomicGet(&ring->head))
+        return false;
+
+    // Acquire the head, so the popping thread has finished copying out of the
+    // slot before it is overwritten.
+    SDL_MemoryBarrierAcquire();
+
+    memcpy(ring->buffer + tail * ring->size, element, ring->size);
+
+    // Publish the element. SDL_AtomicSet() is not guaranteed to order other
+    // memory, so release the element's contents before the new tail.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ring->tail, next);
+    return true;
+}
+
+bool ring_pop(Ring *ring, void *element)
+{
+    int head = SDL_AtomicGet(&ring->head);
+
+    if (head == SDL_AtomicGet(&ring->tail))
+        return false;
+
+    // Acquire the tail, so the element's contents are seen as they were
+    // pushed.
+    SDL_MemoryBarrierAcquire();
+
+    if (element)
+        memcpy(element, ring->buffer + head * ring->size, ring->size);
+
+    // Release the slot back to the pushing thread only once it has been
+    // copied out.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ring->head, (head + 1) % ring->slots);
+    return true;
+}
+
+int ring_length(Ring *ring)
+{
+    int head = SDL_AtomicGet(&ring->head);
+    int tail = SDL_AtomicGet(&ring->tail);
+    return (tail - head + ring->slots) % ring->slots;
+}
+
+void ring_destroy(Ring *ring)
+{
+    free(ring);
+}
@@ -0,0 +1,68 @@
+#ifndef RING_H
+#define RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * A bounded first in first out queue of fixed size elements for passing data
+ * from one thread to another. Pushing and popping are lock free and never
+ * wait: pushing to a full ring and popping from an empty ring fail instead.
+ * The elements are stored in a circular buffer allocated when the ring is
+ * created, so neither touches the heap.
+ * 
+ * Thread safe for one thread pushing and one thread popping at once.
+ */
+typedef struct Ring Ring;
+
+/**
+ * Create a new empty ring.
+ * 
+ * @param size The size of each element.
+ * @param capacity The most elements the ring holds at once.
+ * 
+ * @returns Pointer to the ring, or NULL on failure.
+ */
+Ring *ring_create(size_t size, int capacity);
+
+/**
+ * Copy an element onto the back of the ring. Only called by the pushing
+ * thread.
+ * 
+ * @param ring The ring to push to.
+ * @param element Pointer to the element to copy.
+ * 
+ * @returns True on success, false if the ring is full.
+ */
+bool ring_push(Ring *ring, const void *element);
+
+/**
+ * Copy the element at the front of the ring into the provided element, and
+ * then remove it. Only called by the popping thread.
+ * 
+ * @param ring The ring to pop from.
+ * @param element Pointer to an element to copy the front element into, or
+ * NULL to discard it.
+ * 
+ * @returns True on success, false if the ring is empty.
+ */
+bool ring_pop(Ring *ring, void *element);
+
+/**
+ * Get the number of elements in the ring. The number may have changed by the
+ * time it is returned if another thread is using the ring.
+ * 
+ * @param ring The ring.
+ * @returns The number of elements.
+ */
+int ring_length(Ring *ring);
+
+/**
+ * Deallocate a ring and its elements. Using the ring after this call is
+ * undefined.
+ * 
+ * @param ring The ring to destroy.
+ */
+void ring_destroy(Ring *ring);
+
+#endif // RING_H
@@ -1,58 +1,46 @@
 #include "util/time.h"
 
-#include <stdlib.h>
-
 #include "SDL2/SDL.h"
 
-// Time incrementing the current global time.
-SDL_TimerID s_time_timer = -1;
-
-// Mutex protecting concurrent access to the global time.
-SDL_mutex *s_time_mutex = NULL;
-
-// The current global time.
-Time s_time = 0;
-
-uint32_t time_s_callback(uint32_t interval, void *data)
-{
-    SDL_LockMutex(s_time_mutex);
-    ++s_time;
-    SDL_UnlockMutex(s_time_mutex);
-    return interval;
-}
+// The performance counter when the time interface was initialised, and the
+// counter's ticks per second. Written once before any other thread reads the
+// time, and only read afterwards, so reading needs no lock.
+static uint64_t s_time_start = 0;
+static uint64_t s_time_frequency = 0;
 
 void time_initialise()
 {
-    s_time_mutex = SDL_CreateMutex();
-    SDL_LockMutex(s_time_mutex);
-    s_time_timer = SDL_AddTimer(1, time_s_callback, NULL);
-    SDL_UnlockMutex(s_time_mutex);
+    s_time_frequency = SDL_GetPerformanceFrequency();
+    s_time_start = SDL_GetPerformanceCounter();
 }
 
 Time time_global()
 {
-    SDL_LockMutex(s_time_mutex);
-    Time now = s_time;
-    SDL_UnlockMutex(s_time_mutex);
-    return now;
+    uint64_t ticks = SDL_GetPerformanceCounter() - s_time_start;
+
+    // Convert whole seconds and the remaining ticks separately, so that
+    // multiplying by a billion does not overflow.
+    uint64_t seconds = ticks / s_time_frequency;
+    uint64_t remainder = ticks % s_time_frequency;
+
+    return seconds * TIME_SECOND + remainder * TIME_SECOND / s_time_frequency;
 }
 
-Time time_since_last(Time *time)
+Time time_since_last(Time *timer)
 {
-    SDL_LockMutex(s_time_mutex);
+    Time now = time_global();
 
     // Calculate the time elapsed since the last call.
-    Time elapsed = s_time - *time;
+    Time elapsed = now - *timer;
 
     // Set the time when called last to now.
-    *time = s_time;
+    *timer = now;
 
-    SDL_UnlockMutex(s_time_mutex);
     return elapsed;
 }
 
 void time_deinitialise()
 {
-    SDL_DestroyMutex(s_time_mutex);
-    SDL_RemoveTimer(s_time_timer);
-}
\ No newline at end of file
+    s_time_start = 0;
+    s_time_frequency = 0;
+}
@@ -3,38 +3,61 @@
 
 #include <stdint.h>
 
+// The number of nanoseconds in a second.
+#define TIME_SECOND 1000000000ull
+
+/**
+ * A point in or span of time, in nanoseconds. Points in time are measured from
+ * when the time interface was initialised.
+ */
 typedef uint64_t Time;
 
 /**
  * Initialise the time interface.
  * 
- * Creates the SDL timer responsible for incrementing the global time, and
- * initialises 
+ * Records the start of global time from the monotonic high resolution
+ * performance counter. Must be called before any thread reads the time, after
+ * which reading the time is lock free.
  */
 void time_initialise();
 
 /**
- * Get the current global time since the program started.
+ * Get the current global time since the time interface was initialised.
+ * 
+ * Thread safe and lock free.
  * 
- * @return The global time.
+ * @return The global time in nanoseconds.
  */
 Time time_global();
 
 /**
- * Determine how many milliseconds have elapsed since the last time this time
- * was checked.
+ * Determine how much time has elapsed since the last time this timer was
+ * checked, and set the timer to the current global time. Each caller keeps its
+ * own timer, so callers measure their own deltas independently.
  * 
- * Sets the time to the current global time.
+ * Thread safe and lock free, provided each timer is only used by one thread.
  * 
- * @param timer The timer to check.
- * @return How many milliseconds have elapsed since this timer was last checked.
+ * @param timer The timer to check, holding the global time it was last
+ * checked.
+ * @return How many nanoseconds have elapsed since this timer was last checked.
  */
 Time time_since_last(Time *timer);
 
+/**
+ * Convert a span of time to seconds.
+ * 
+ * @param time The span of time in nanoseconds.
+ * @return The span of time in seconds.
+ */
+static inline double time_to_seconds(Time time)
+{
+    return (double)time / TIME_SECOND;
+}
+
 /**
  * Elgantly destroy data related to the time interface. Using time after
  * this function has been called is undefined.
  */
 void time_deinitialise();
 
-#endif // TIME_H
\ No newline at end of file
+#endif // TIME_H
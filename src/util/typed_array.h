@@ -0,0 +1,200 @@
+#ifndef TYPED_ARRAY_H
+#define TYPED_ARRAY_H
+
+#include <assert.h>
+
+#include "util/array.h"
+
+/**
+ * Define a set of functions operating on an Array of a single element type,
+ * prefixed with the provided name. For example
+ * 
+ *     ARRAY_DEFINE(pair_array, Pair)
+ * 
+ * defines pair_array_create(), pair_array_get(), pair_array_push_back() and so
+ * on, mirroring every function of array.h.
+ * 
+ * The arrays are ordinary Arrays, so they can be passed to the array_
+ * functions and the typed functions interchangeably. The typed functions take
+ * and return elements by their type rather than through void pointers, and
+ * the accessors used in inner loops are inlined with the element size known
+ * at compile time, so copying an element is an assignment rather than a call
+ * to memcpy. Operations that shift or reallocate the buffer forward to the
+ * array_ functions.
+ * 
+ * Every Array passed to the typed functions must have been created with an
+ * element size of sizeof(type).
+ * 
+ * @param name The prefix of the defined functions.
+ * @param type The element type of the array.
+ */
+#define ARRAY_DEFINE(name, type)                                               \
+                                                                               \
+static inline Array *name##_create()                                           \
+{                                                                              \
+    return array_create(sizeof(type));                                         \
+}                                                                              \
+                                                                               \
+static inline Array *name##_create_inline(int n)                               \
+{                                                                              \
+    return array_create_inline(sizeof(type), n);                               \
+}                                                                              \
+                                                                               \
+static inline Array *name##_create_arena(Arena *arena)                         \
+{                                                                              \
+    return array_create_arena(arena, sizeof(type));                            \
+}                                                                              \
+                                                                               \
+static inline Array *name##_create_from_array(Array *array)                    \
+{                                                                              \
+    assert(array->size == sizeof(type));                                       \
+    return array_create_from_array(array);                                     \
+}                                                                              \
+                                                                               \
+static inline bool name##_allocate(Array *array, int n)                        \
+{                                                                              \
+    return array_allocate(array, n);                                           \
+}                                                                              \
+                                                                               \
+static inline bool name##_reserve(Array *array, int capacity)                  \
+{                                                                              \
+    return array_reserve(array, capacity);                                     \
+}                                                                              \
+                                                                               \
+static inline bool name##_shrink_to_fit(Array *array)                          \
+{                                                                              \
+    return array_shrink_to_fit(array);                                         \
+}                                                                              \
+                                                                               \
+static inline bool name##_at_pointer(Array *array, int index, type **element)  \
+{                                                                              \
+    if (!array || index < 0 || index >= (int)array->length)                    \
+        return false;                                                          \
+                                                                               \
+    *element = (type*)array->buffer + index;                                   \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_at_copy(Array *array, int index, type *element)      \
+{                                                                              \
+    if (!array || index < 0 || index >= (int)array->length)                    \
+        return false;                                                          \
+                                                                               \
+    *element = *((type*)array->buffer + index);                                \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+static inline type *name##_get(Array *array, int index)                        \
+{                                                                              \
+    assert(array->size == sizeof(type));                                       \
+    return (type*)array->buffer + index;                                       \
+}                                                                              \
+                                                                               \
+static inline void name##_set(Array *array, int index, type element)           \
+{                                                                              \
+    assert(array->size == sizeof(type));                                       \
+    *((type*)array->buffer + index) = element;                                 \
+}                                                                              \
+                                                                               \
+static inline bool name##_front(Array *array, type **element)                  \
+{                                                                              \
+    return name##_at_pointer(array, 0, element);                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_back(Array *array, type **element)                   \
+{                                                                              \
+    if (!array || array->length == 0)                                          \
+        return false;                                                          \
+                                                                               \
+    return name##_at_pointer(array, array->length - 1, element);               \
+}                                                                              \
+                                                                               \
+static inline type *name##_data(Array *array)                                  \
+{                                                                              \
+    assert(array->size == sizeof(type));                                       \
+    return array->buffer;                                                      \
+}                                                                              \
+                                                                               \
+static inline bool name##_empty(Array *array)                                  \
+{                                                                              \
+    return array->length == 0;                                                 \
+}                                                                              \
+                                                                               \
+static inline int name##_length(Array *array)                                  \
+{                                                                              \
+    return array->length;                                                      \
+}                                                                              \
+                                                                               \
+static inline void name##_clear(Array *array)                                  \
+{                                                                              \
+    array_clear(array);                                                        \
+}                                                                              \
+                                                                               \
+static inline bool name##_resize(Array *array, int length)                     \
+{                                                                              \
+    return array_resize(array, length);                                        \
+}                                                                              \
+                                                                               \
+static inline bool name##_insert(Array *array, int index, type element)        \
+{                                                                              \
+    return array_insert(array, index, &element);                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_push_back(Array *array, type element)                \
+{                                                                              \
+    assert(array->size == sizeof(type));                                       \
+                                                                               \
+    /* Only call out to grow the buffer when it is full. */                    \
+    if (array->length == array->capacity && !array_allocate(array, 1))         \
+        return false;                                                          \
+                                                                               \
+    *((type*)array->buffer + array->length) = element;                         \
+    array->length++;                                                           \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_append_n(Array *array, const type *elements, int n)  \
+{                                                                              \
+    assert(array->size == sizeof(type));                                       \
+    return array_append_n(array, elements, n);                                 \
+}                                                                              \
+                                                                               \
+static inline bool name##_pop_back(Array *array, type *element)                \
+{                                                                              \
+    return array_pop_back(array, element);                                     \
+}                                                                              \
+                                                                               \
+static inline bool name##_erase(Array *array, int index)                       \
+{                                                                              \
+    return array_erase(array, index);                                          \
+}                                                                              \
+                                                                               \
+static inline bool name##_erase_range(                                         \
+    Array *array,                                                              \
+    int index_from,                                                            \
+    int index_to                                                               \
+) {                                                                            \
+    return array_erase_range(array, index_from, index_to);                     \
+}                                                                              \
+                                                                               \
+static inline bool name##_erase_unordered(Array *array, int index)             \
+{                                                                              \
+    return array_erase_unordered(array, index);                                \
+}                                                                              \
+                                                                               \
+static inline void name##_apply(                                               \
+    Array *array,                                                              \
+    void (*func)(type *element, void *data),                                   \
+    void *data                                                                 \
+) {                                                                            \
+    type *buffer = array->buffer;                                              \
+    for (int i = 0; i < (int)array->length; i++)                               \
+        func(buffer + i, data);                                                \
+}                                                                              \
+                                                                               \
+static inline void name##_destroy(Array *array)                                \
+{                                                                              \
+    array_destroy(array);                                                      \
+}
+
+#endif // TYPED_ARRAY_H
@@ -111,6 +111,25 @@ static inline Vector vector_rot(Vector v, double theta)
     return rv;
 }
 
+/** 
+ * Rotates a vector by an angle whose sine and cosine are already known. Useful
+ * for rotating many vectors by the same angle.
+ * 
+ * @param v The vector to rotate.
+ * @param cos_theta Cosine of the angle to rotate by.
+ * @param sin_theta Sine of the angle to rotate by.
+ * 
+ * @return The rotated vector.
+ */
+static inline Vector vector_rot_cs(Vector v, double cos_theta, double sin_theta)
+{
+    Vector rv = {
+        v.x * cos_theta - v.y * sin_theta,
+        v.x * sin_theta + v.y * cos_theta
+    };
+    return rv;
+}
+
 /** 
  * Returns vector magnitude.
  * 
@@ -119,7 +138,7 @@ static inline Vector vector_rot(Vector v, double theta)
  */
 static inline double vector_mag(Vector v)
 {
-    return sqrt(pow(v.x, 2) + pow(v.y, 2)); 
+    return sqrt(v.x * v.x + v.y * v.y);
 }
 
 /** 
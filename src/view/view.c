@@ -33,6 +33,8 @@ View *view_create(
     view->window = window;
     view->port = port;
     view->mutex = SDL_CreateMutex();
+    view->commands = ring_create(sizeof(Command), VIEW_COMMAND_CAPACITY);
+    SDL_AtomicSet(&view->dropped_commands, 0);
     view->draw_function = draw_function;
     view->data = data;
 
@@ -51,6 +53,9 @@ void view_draw(void *data)
     View *view = data;
     SDL_LockMutex(view->mutex);
 
+    // Perform the controller's commands before drawing the frame.
+    view_handle_commands(view);
+
     // Clear the screen
     SDL_SetRenderDrawColor(view->renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
     SDL_RenderClear(view->renderer);
@@ -86,19 +91,17 @@ uint32_t view_fps_counter_callback(uint32_t interval, void *data)
     return interval;
 }
 
-void view_resize_window(View *view, int x, int y)
+/**
+ * Resize the view's renderer to a new window size. The view must be locked.
+ */
+void view_apply_resize(View *view, int x, int y)
 {
-    if (!view) {
-        return;
-    }
-
     // Window width and height must be greater than 0.
     if (x <= 0 || y <= 0) {
         return;
     }
 
     /// @BUG: Resizing doesn't work unless the renderer is recreated.
-    SDL_LockMutex(view->mutex);
     SDL_DestroyRenderer(view->renderer);
     view->renderer = SDL_CreateRenderer(
         view->window,
@@ -106,12 +109,13 @@ void view_resize_window(View *view, int x, int y)
         SDL_RENDERER_ACCELERATED
     );
     view->port->screen = (Vector){x / 2, y / 2};
-    SDL_UnlockMutex(view->mutex);
 }
 
-void view_move(View *view, Direction direction, bool state)
+/**
+ * Toggle the movement of the view in a direction. The view must be locked.
+ */
+void view_apply_move(View *view, Direction direction, bool state)
 {
-    SDL_LockMutex(view->mutex);
     switch (direction)
     {
         case DIRECTION_NORTH: view_port_move_up(view->port,    state); break;
@@ -122,6 +126,59 @@ void view_move(View *view, Direction direction, bool state)
         case DIRECTION_OUT:   view_port_move_out(view->port,   state); break;
         default: break;
     }
+}
+
+void view_resize_window(View *view, int x, int y)
+{
+    if (!view) {
+        return;
+    }
+
+    SDL_LockMutex(view->mutex);
+    view_apply_resize(view, x, y);
+    SDL_UnlockMutex(view->mutex);
+}
+
+bool view_command(View *view, Command command)
+{
+    if (!view || !view->commands)
+        return false;
+
+    if (ring_push(view->commands, &command))
+        return true;
+
+    SDL_AtomicAdd(&view->dropped_commands, 1);
+    return false;
+}
+
+void view_handle_commands(View *view)
+{
+    if (!view->commands)
+        return;
+
+    Command command;
+    while (ring_pop(view->commands, &command)) {
+        switch (command.type)
+        {
+            case COMMAND_VIEW_MOVE:
+                view_apply_move(
+                    view,
+                    command.move.direction,
+                    command.move.state
+                );
+                break;
+            case COMMAND_VIEW_RESIZE:
+                view_apply_resize(view, command.resize.x, command.resize.y);
+                break;
+            default: break;
+        }
+    }
+}
+
+void view_move(View *view, Direction direction, bool state)
+{
+    SDL_LockMutex(view->mutex);
+    view_apply_move(view, direction, state);
     SDL_UnlockMutex(view->mutex);
 }
 
@@ -172,6 +229,7 @@ void view_destroy(View *view)
     // Destroy the view.
     SDL_DestroyRenderer(view->renderer);
     SDL_DestroyMutex(view->mutex);
+    ring_destroy(view->commands);
 
     free(view);
 }
@@ -5,8 +5,12 @@
 
 #include "util/definitions.h"
 #include "util/intervalthread.h"
+#include "util/ring.h"
 #include "view/view_port.h"
 
+// The most commands that can be queued for the view at once.
+#define VIEW_COMMAND_CAPACITY 64
+
 /**
  * Represents the graphical component of the application, keeping track of the
  * renderering thread, user view of the world space (moving the user's view
@@ -24,6 +28,10 @@ struct View {
     IntervalThread *thread;
     // Mutex protecting concurrent access of view data.
     SDL_mutex *mutex;
+    // Commands queued by the controller, performed at the start of each draw.
+    Ring *commands;
+    // Commands dropped because the queue was full.
+    SDL_atomic_t dropped_commands;
     // Function that can be binded to draw onto the window. Takes this view to
     // draw onto and a void* as the drawn data.
     void(*draw_function)(View*, void*);
@@ -81,6 +89,27 @@ uint32_t view_fps_counter_callback(uint32_t interval, void *data);
  */
 void view_resize_window(View *view, int x, int y);
 
+/**
+ * Queue a command for the view to perform at the start of its next draw.
+ * 
+ * Never blocks. Must only be called from one thread.
+ * 
+ * @param view The view to command.
+ * @param command The command to queue.
+ * 
+ * @returns True on success, false if the view's queue is full, in which case
+ * the command is dropped and counted in View->dropped_commands.
+ */
+bool view_command(View *view, Command command);
+
+/**
+ * Perform every command queued for the view. Called by the view's thread with
+ * the view locked.
+ * 
+ * @param view The view.
+ */
+void view_handle_commands(View *view);
+
 /**
  * Toggle the movement of the view in a given direction on or off.
  * 
@@ -36,6 +36,9 @@ ViewPort *view_port_create(
     view_port->movement.v_max = velocity_max;
     view_port->movement.a = acceleration;
 
+    // Measure the first update from when the view port was created.
+    view_port->time = time_global();
+
     return view_port;
 }
 
@@ -133,7 +136,7 @@ void view_port_update(ViewPort *view_port)
         }
     }
 
-    double dt = time_since_last(&view_port->time) * 0.001;
+    double dt = time_to_seconds(time_since_last(&view_port->time));
 
     view_port->position.x += m->v_x * view_port->dimensions.x * dt;
     view_port->position.y += m->v_y * view_port->dimensions.y * dt;